@@ -0,0 +1,57 @@
+#include "bench_common.hpp"
+
+#include <map>
+
+#include <majorminer.hpp>
+#include <common/graph_gen.hpp>
+
+using namespace majorminer;
+
+const BenchInstance& majorminer::getCliqueOnChimera(fuint32_t size)
+{
+  static std::map<fuint32_t, std::unique_ptr<BenchInstance>> instances{};
+  static std::mutex instanceMutex{};
+  std::lock_guard lock{instanceMutex};
+  auto& instance = instances[size];
+  if (instance.get() != nullptr) return *instance;
+
+  instance = std::make_unique<BenchInstance>();
+  instance->m_source = generate_completegraph(size + 4);
+  instance->m_target = generate_chimera(size, size);
+  EmbeddingSuite suite{instance->m_source, instance->m_target};
+  suite.setSeed(size);
+  auto embedding = suite.find_embedding();
+  instance->m_embedding.insert(embedding.begin(), embedding.end());
+  return *instance;
+}
+
+vertex_t majorminer::getLongestChain(const embedding_mapping_t& embedding)
+{
+  vertex_t longest = 0;
+  size_t longestSize = 0;
+  for (const auto& mapped : embedding)
+  {
+    size_t size = embedding.count(mapped.first);
+    if (size > longestSize || (size == longestSize && mapped.first < longest))
+    {
+      longest = mapped.first;
+      longestSize = size;
+    }
+  }
+  return longest;
+}
+
+adjacency_list_t majorminer::getChainSubgraph(const BenchInstance& instance, vertex_t source)
+{
+  nodeset_t chain{};
+  auto range = instance.m_embedding.equal_range(source);
+  for (auto it = range.first; it != range.second; ++it) chain.insert(it->second);
+  adjacency_list_t subgraph{};
+  for (const auto& edge : instance.m_target)
+  {
+    if (!chain.contains(edge.first) || !chain.contains(edge.second)) continue;
+    subgraph.insert(edge);
+    subgraph.insert(std::make_pair(edge.second, edge.first));
+  }
+  return subgraph;
+}
@@ -0,0 +1,32 @@
+#ifndef __MAJORMINER_BENCH_COMMON_HPP_
+#define __MAJORMINER_BENCH_COMMON_HPP_
+
+#include <benchmark/benchmark.h>
+#include <majorminer_types.hpp>
+
+namespace majorminer
+{
+  // An embedding of a clique with size + 4 vertices into a Chimera graph
+  // with size x size unit cells. Computed once per size and shared by all
+  // benchmarks.
+  struct BenchInstance
+  {
+    graph_t m_source;
+    graph_t m_target;
+    embedding_mapping_t m_embedding;
+  };
+
+  const BenchInstance& getCliqueOnChimera(fuint32_t size);
+
+  // Source vertex with the longest chain
+  vertex_t getLongestChain(const embedding_mapping_t& embedding);
+
+  // Adjacency list of the subgraph of the target induced by the chain
+  adjacency_list_t getChainSubgraph(const BenchInstance& instance, vertex_t source);
+}
+
+// Target sizes (unit cells per side) every kernel is measured on
+#define MM_BENCH_TARGET_SIZES ->Arg(4)->Arg(8)->Arg(16)
+
+
+#endif
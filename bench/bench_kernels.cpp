@@ -0,0 +1,129 @@
+#include "bench_common.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include <majorminer.hpp>
+#include <common/cut_vertex.hpp>
+#include <common/graph_gen.hpp>
+#include <common/utils.hpp>
+
+#include "utils/state_gen.hpp"
+
+using namespace majorminer;
+
+static void BM_IterateSourceMappingAdjacent(benchmark::State& bench)
+{
+  const auto& instance = getCliqueOnChimera(bench.range(0));
+  StateGen gen{instance.m_source, instance.m_target};
+  gen.addMapping(instance.m_embedding);
+  auto state = gen.get();
+  fuint32_t nbSources = state->getNumberSourceVertices();
+
+  for (auto _ : bench)
+  {
+    fuint32_t visited = 0;
+    for (vertex_t source = 0; source < nbSources; ++source)
+    {
+      state->iterateSourceMappingAdjacent<false>(source, [&](vertex_t adjacent, vertex_t){
+        visited += adjacent & 1;
+        return false;
+      });
+    }
+    benchmark::DoNotOptimize(visited);
+  }
+  bench.SetItemsProcessed(bench.iterations() * instance.m_embedding.size());
+}
+BENCHMARK(BM_IterateSourceMappingAdjacent) MM_BENCH_TARGET_SIZES;
+
+static void BM_IsCutVertex(benchmark::State& bench)
+{
+  const auto& instance = getCliqueOnChimera(bench.range(0));
+  StateGen gen{instance.m_source, instance.m_target};
+  gen.addMapping(instance.m_embedding);
+  auto state = gen.get();
+  vertex_t source = getLongestChain(instance.m_embedding);
+  Vector<vertex_t> chain{};
+  auto range = instance.m_embedding.equal_range(source);
+  for (auto it = range.first; it != range.second; ++it) chain.push_back(it->second);
+
+  for (auto _ : bench)
+  {
+    fuint32_t nbCutVertices = 0;
+    for (vertex_t target : chain) nbCutVertices += isCutVertex(*state, source, target);
+    benchmark::DoNotOptimize(nbCutVertices);
+  }
+  bench.SetItemsProcessed(bench.iterations() * chain.size());
+}
+BENCHMARK(BM_IsCutVertex) MM_BENCH_TARGET_SIZES;
+
+static void BM_IdentifyCutVertices(benchmark::State& bench)
+{
+  const auto& instance = getCliqueOnChimera(bench.range(0));
+  vertex_t source = getLongestChain(instance.m_embedding);
+  adjacency_list_t subgraph = getChainSubgraph(instance, source);
+  fuint32_t n = instance.m_embedding.count(source);
+
+  for (auto _ : bench)
+  {
+    nodeset_t cut{};
+    identifiyCutVertices(cut, subgraph, n);
+    benchmark::DoNotOptimize(cut.size());
+  }
+  bench.counters["chain"] = n;
+}
+BENCHMARK(BM_IdentifyCutVertices) MM_BENCH_TARGET_SIZES;
+
+// Applies a batch of insertions and deletions that cancel out, so every
+// iteration starts from the same state.
+static void BM_Synchronize(benchmark::State& bench)
+{
+  const auto& instance = getCliqueOnChimera(bench.range(0));
+  EmbeddingSuite suite{instance.m_source, instance.m_target};
+  StateGen gen{instance.m_source, instance.m_target};
+  gen.addMapping(instance.m_embedding);
+  auto state = gen.get();
+  EmbeddingManager manager{suite, *state};
+  Vector<fuint32_pair_t> pairs(instance.m_embedding.begin(), instance.m_embedding.end());
+
+  for (auto _ : bench)
+  {
+    for (const auto& mapped : pairs)
+    {
+      manager.deleteMappingPair(mapped.first, mapped.second);
+      manager.commit();
+      manager.insertMappingPair(mapped.first, mapped.second);
+      manager.commit();
+    }
+    manager.synchronize();
+  }
+  bench.SetItemsProcessed(bench.iterations() * 2 * pairs.size());
+}
+BENCHMARK(BM_Synchronize) MM_BENCH_TARGET_SIZES;
+
+static void BM_ImportGraph(benchmark::State& bench)
+{
+  fuint32_t size = bench.range(0);
+  graph_t chimera = generate_chimera(size, size);
+  std::filesystem::create_directories("bench_data");
+  std::string filename = "bench_data/chimera_" + std::to_string(size) + ".txt";
+  {
+    std::ofstream file(filename, std::ios::trunc);
+    file << "[";
+    bool first = true;
+    for (const auto& edge : chimera)
+    {
+      file << (first ? "" : ", ") << "[" << edge.first << ", " << edge.second << "]";
+      first = false;
+    }
+    file << "]";
+  }
+
+  for (auto _ : bench)
+  {
+    graph_t graph = import_graph(filename);
+    benchmark::DoNotOptimize(graph.size());
+  }
+  bench.SetItemsProcessed(bench.iterations() * chimera.size());
+}
+BENCHMARK(BM_ImportGraph) MM_BENCH_TARGET_SIZES;
@@ -0,0 +1,108 @@
+#include "bench_common.hpp"
+
+#include <majorminer.hpp>
+#include <common/graph_gen.hpp>
+#include <common/graph_info.hpp>
+#include <initial/network_simplex.hpp>
+#include <initial/super_vertex_reducer.hpp>
+#include <initial/csc_evolutionary.hpp>
+#include <lmrp/lmrp_heuristic.hpp>
+#include <lmrp/lmrp_king_subgraph.hpp>
+
+#include "utils/state_gen.hpp"
+
+using namespace majorminer;
+
+// Places the longest chain again while all other chains stay mapped
+static void BM_NetworkSimplexEmbeddNode(benchmark::State& bench)
+{
+  const auto& instance = getCliqueOnChimera(bench.range(0));
+  vertex_t source = getLongestChain(instance.m_embedding);
+  EmbeddingSuite suite{instance.m_source, instance.m_target};
+  StateGen gen{instance.m_source, instance.m_target};
+  gen.addMapping(instance.m_embedding);
+  gen.removeSuperVertex(source);
+  auto state = gen.get();
+  EmbeddingManager manager{suite, *state};
+  NetworkSimplexWrapper wrapper{*state, manager};
+
+  for (auto _ : bench)
+  {
+    wrapper.embeddNode(source);
+    benchmark::DoNotOptimize(wrapper.getMapped().size());
+  }
+}
+BENCHMARK(BM_NetworkSimplexEmbeddNode) MM_BENCH_TARGET_SIZES;
+
+static void BM_SuperVertexReducer(benchmark::State& bench)
+{
+  const auto& instance = getCliqueOnChimera(bench.range(0));
+  vertex_t source = getLongestChain(instance.m_embedding);
+  StateGen gen{instance.m_source, instance.m_target};
+  gen.addMapping(instance.m_embedding);
+  auto state = gen.get();
+
+  for (auto _ : bench)
+  {
+    SuperVertexReducer reducer{*state, source};
+    reducer.setSeed(17);
+    reducer.initialize();
+    reducer.optimize();
+    benchmark::DoNotOptimize(reducer.getSuperVertex().size());
+  }
+}
+BENCHMARK(BM_SuperVertexReducer) MM_BENCH_TARGET_SIZES;
+
+static void BM_EvolutionaryCSCReducer(benchmark::State& bench)
+{
+  const auto& instance = getCliqueOnChimera(bench.range(0));
+  vertex_t source = getLongestChain(instance.m_embedding);
+  StateGen gen{instance.m_source, instance.m_target};
+  gen.addMapping(instance.m_embedding);
+  auto state = gen.get();
+  EmbeddingConfig config{};
+  config.m_deterministic = true;
+  config.m_seed = 17;
+  state->setConfig(config);
+
+  for (auto _ : bench)
+  {
+    EvolutionaryCSCReducer reducer{*state, source};
+    reducer.setMultithreaded(false);
+    reducer.optimize();
+    benchmark::DoNotOptimize(reducer.getPlacement().size());
+  }
+}
+BENCHMARK(BM_EvolutionaryCSCReducer) MM_BENCH_TARGET_SIZES->Unit(benchmark::kMillisecond);
+
+// A row and a column chain crossing in the middle of a King's graph with
+// size x size vertices. The crater is placed at the crossing.
+static void BM_LMRPHeuristic(benchmark::State& bench)
+{
+  fuint32_t size = 2 * bench.range(0) + 1;
+  graph_t king = generate_king(size, size);
+  graph_t triangle{ {0, 1}, {0, 2}, {1, 2} };
+  KingGraphInfo info{size, size};
+  KingLMRPSubgraph subgraph{info};
+  StateGen gen{triangle, king};
+  fuint32_t middle = size / 2;
+  for (fuint32_t idx = 0; idx < size; ++idx)
+  {
+    gen.addMapping({ {0, middle * size + idx}, {1, idx * size + middle} });
+  }
+  gen.addMapping({ {2, 0} });
+  auto state = gen.get();
+  state->setLMRPSubgraphGenerator(&subgraph);
+  vertex_t center = middle * size + middle;
+
+  for (auto _ : bench)
+  {
+    LMRPHeuristic heuristic{*state, center};
+    heuristic.optimize();
+    benchmark::DoNotOptimize(heuristic.improved());
+    bench.PauseTiming();
+    subgraph.commit(center);
+    bench.ResumeTiming();
+  }
+}
+BENCHMARK(BM_LMRPHeuristic) MM_BENCH_TARGET_SIZES;
@@ -0,0 +1,297 @@
+#include <majorminer.hpp>
+#include <common/graph_gen.hpp>
+#include <common/embedding_analyzer.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+#include "utils/qubo_problems.hpp"
+
+using namespace majorminer;
+
+// Embeds a corpus of source graphs into Chimera, King's and Pegasus targets
+// of increasing size and writes the timings and the quality as JSON.
+//
+// Every repetition is seeded with its number, unless --nondeterministic
+// is given. The mode is written to the JSON.
+//
+// Usage: majorminer_e2e [--out file] [--repeat n] [--filter substring]
+//                       [--edge-list file]... [--nondeterministic]
+namespace
+{
+  struct NamedGraph
+  {
+    std::string m_name;
+    std::function<graph_t()> m_generate;
+  };
+
+  // Wall time in milliseconds, the phases are taken from the profile of the suite
+  struct PhaseTimes
+  {
+    double m_placement = 0;
+    double m_mutation = 0; // mutations between the placements
+    double m_overlapReduction = 0;
+    double m_lmrp = 0;
+    double m_replaceOverlapping = 0;
+    double m_total = 0;
+  };
+
+  struct RunResult
+  {
+    std::string m_instance;
+    std::string m_target;
+    uint64_t m_seed;
+    bool m_valid;
+    std::string m_error;
+    PhaseTimes m_times;
+    EmbeddingStatistics m_stats;
+  };
+
+  struct Options
+  {
+    std::string m_output = "e2e_results.json";
+    fuint32_t m_repeat = 1;
+    std::string m_filter;
+    Vector<std::string> m_edgeLists;
+    bool m_deterministic = true;
+  };
+
+  Vector<NamedGraph> getInstances(const Options& options)
+  {
+    Vector<NamedGraph> instances{};
+    for (fuint32_t n : { 6, 10, 14 })
+    {
+      instances.push_back({ "clique_" + std::to_string(n), [n](){ return generate_completegraph(n); } });
+    }
+    for (fuint32_t n : { 12, 40 })
+    {
+      instances.push_back({ "cycle_" + std::to_string(n), [n](){ return generate_cyclegraph(n); } });
+    }
+    for (double p : { 0.2, 0.35, 0.5 })
+    {
+      std::stringstream name{};
+      name << "erdosrenyi_16_" << p;
+      instances.push_back({ name.str(), [p](){ return generate_erdosrenyi_csr(16, p, 1).toGraph(); } });
+    }
+    instances.push_back({ "qubo_tsp_4", [](){
+      return quboTSP(4, [](fuint32_t i, fuint32_t j){ return i + j; });
+    } });
+    instances.push_back({ "qubo_matrix_eq_4", [](){
+      return createConstraintMatrix(4, QConstraintType::EQUAL, 100)();
+    } });
+    for (const auto& filename : options.m_edgeLists)
+    {
+      instances.push_back({ filename, [filename](){ return import_graph(filename); } });
+    }
+    return instances;
+  }
+
+  Vector<NamedGraph> getTargets()
+  {
+    Vector<NamedGraph> targets{};
+    for (fuint32_t size : { 4, 8, 12 })
+    {
+      targets.push_back({ "chimera_" + std::to_string(size), [size](){ return generate_chimera(size, size); } });
+    }
+    for (fuint32_t size : { 8, 16 })
+    {
+      targets.push_back({ "king_" + std::to_string(size), [size](){ return generate_king(size, size); } });
+    }
+    for (fuint32_t m : { 4, 6 })
+    {
+      targets.push_back({ "pegasus_" + std::to_string(m), [m](){ return generate_pegasus(m); } });
+    }
+    return targets;
+  }
+
+  fuint32_t getNbVertices(const graph_t& graph)
+  {
+    nodeset_t vertices{};
+    for (const auto& edge : graph)
+    {
+      vertices.insert(edge.first);
+      vertices.insert(edge.second);
+    }
+    return vertices.size();
+  }
+
+  double getPhaseMs(const ProfileReport& profile, const std::string& phase)
+  {
+    const ProfileEntry* entry = profile.find(phase);
+    return entry != nullptr ? entry->m_totalMs : 0;
+  }
+
+  RunResult run(const NamedGraph& instance, const graph_t& source,
+    const NamedGraph& target, const graph_t& targetGraph, uint64_t seed, bool deterministic)
+  {
+    RunResult result{ instance.m_name, target.m_name, seed, false, "", PhaseTimes{}, EmbeddingStatistics{} };
+    try
+    {
+      EmbeddingSuite suite{source, targetGraph};
+      if (deterministic) suite.setSeed(seed);
+      suite.setProfiling(true);
+      auto start = std::chrono::steady_clock::now();
+      auto embedding = suite.find_embedding();
+      result.m_times.m_total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      result.m_valid = suite.isValid();
+
+      auto profile = suite.getProfile();
+      result.m_times.m_placement = getPhaseMs(profile, "placement");
+      result.m_times.m_mutation = getPhaseMs(profile, "mutation");
+      result.m_times.m_overlapReduction = getPhaseMs(profile, "overlap reduction");
+      result.m_times.m_lmrp = getPhaseMs(profile, "lmrp");
+      result.m_times.m_replaceOverlapping = getPhaseMs(profile, "replace overlapping");
+      result.m_stats = EmbeddingAnalyzer{embedding, source, targetGraph}.analyze(0);
+    }
+    catch (const std::exception& e)
+    {
+      result.m_error = e.what();
+    }
+    return result;
+  }
+
+  std::string escape(const std::string& text)
+  {
+    std::string escaped{};
+    for (char sym : text)
+    {
+      if (sym == '"' || sym == '\\') escaped += '\\';
+      escaped += sym;
+    }
+    return escaped;
+  }
+
+  void writeResults(std::ostream& os, const Vector<RunResult>& results, bool deterministic)
+  {
+    os << "{\n  \"mode\": \"" << (deterministic ? "deterministic" : "nondeterministic") << "\","
+       << "\n  \"runs\": [";
+    for (size_t idx = 0; idx < results.size(); ++idx)
+    {
+      const auto& result = results[idx];
+      const auto& times = result.m_times;
+      const auto& stats = result.m_stats;
+      os << (idx == 0 ? "\n" : ",\n")
+         << "    { \"instance\": \"" << escape(result.m_instance) << "\""
+         << ", \"target\": \"" << result.m_target << "\"";
+      if (deterministic) os << ", \"seed\": " << result.m_seed;
+      os << ", \"valid\": " << (result.m_valid ? "true" : "false");
+      if (!result.m_error.empty()) os << ", \"error\": \"" << escape(result.m_error) << "\"";
+      os << ",\n      \"timeMs\": { \"total\": " << times.m_total
+         << ", \"placement\": " << times.m_placement
+         << ", \"mutation\": " << times.m_mutation
+         << ", \"overlapReduction\": " << times.m_overlapReduction
+         << ", \"lmrp\": " << times.m_lmrp
+         << ", \"replaceOverlapping\": " << times.m_replaceOverlapping << " }"
+         << ",\n      \"maxChainLength\": " << stats.m_maxChainLength
+         << ", \"meanChainLength\": " << stats.m_meanChainLength
+         << ", \"usedTargets\": " << stats.m_nbUsedTargets
+         << ", \"overlappedTargets\": " << stats.m_nbOverlappedTargets << " }";
+    }
+    os << "\n  ],\n  \"summary\": [";
+
+    // success rate and mean time per pair of instance and target
+    size_t first = 0;
+    bool firstGroup = true;
+    while (first < results.size())
+    {
+      size_t last = first;
+      fuint32_t nbValid = 0;
+      double totalMs = 0;
+      while (last < results.size() && results[last].m_instance == results[first].m_instance
+        && results[last].m_target == results[first].m_target)
+      {
+        nbValid += results[last].m_valid;
+        totalMs += results[last].m_times.m_total;
+        last++;
+      }
+      size_t nbRuns = last - first;
+      os << (firstGroup ? "\n" : ",\n")
+         << "    { \"instance\": \"" << escape(results[first].m_instance) << "\""
+         << ", \"target\": \"" << results[first].m_target << "\""
+         << ", \"runs\": " << nbRuns
+         << ", \"successRate\": " << (static_cast<double>(nbValid) / nbRuns)
+         << ", \"meanTimeMs\": " << (totalMs / nbRuns) << " }";
+      firstGroup = false;
+      first = last;
+    }
+    os << "\n  ]\n}\n";
+  }
+
+  bool parseOptions(int argc, char** argv, Options& options)
+  {
+    for (int idx = 1; idx < argc; ++idx)
+    {
+      std::string arg = argv[idx];
+      if (arg == "--nondeterministic")
+      {
+        options.m_deterministic = false;
+        continue;
+      }
+      if (idx + 1 >= argc) return false;
+      if (arg == "--out") options.m_output = argv[++idx];
+      else if (arg == "--repeat") options.m_repeat = std::max(1UL, std::stoul(argv[++idx]));
+      else if (arg == "--filter") options.m_filter = argv[++idx];
+      else if (arg == "--edge-list") options.m_edgeLists.push_back(argv[++idx]);
+      else return false;
+    }
+    return true;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  Options options{};
+  if (!parseOptions(argc, argv, options))
+  {
+    std::cerr << "Usage: " << argv[0]
+              << " [--out file] [--repeat n] [--filter substring] [--edge-list file]... [--nondeterministic]" << std::endl;
+    return 1;
+  }
+
+  Vector<RunResult> results{};
+  auto targets = getTargets();
+  Vector<graph_t> targetGraphs{};
+  for (const auto& target : targets) targetGraphs.push_back(target.m_generate());
+
+  for (const auto& instance : getInstances(options))
+  {
+    graph_t source{};
+    try
+    {
+      source = instance.m_generate();
+    }
+    catch (const std::exception& e)
+    {
+      std::cerr << "Skipping " << instance.m_name << ": " << e.what() << std::endl;
+      continue;
+    }
+    fuint32_t nbSourceVertices = getNbVertices(source);
+    for (size_t targetIdx = 0; targetIdx < targets.size(); ++targetIdx)
+    {
+      const auto& target = targets[targetIdx];
+      std::string name = instance.m_name + "/" + target.m_name;
+      if (!options.m_filter.empty() && name.find(options.m_filter) == std::string::npos) continue;
+      if (nbSourceVertices > getNbVertices(targetGraphs[targetIdx])) continue;
+      for (fuint32_t repetition = 0; repetition < options.m_repeat; ++repetition)
+      {
+        results.push_back(run(instance, source, target, targetGraphs[targetIdx], repetition + 1, options.m_deterministic));
+        const auto& result = results.back();
+        std::cerr << name << (options.m_deterministic ? " seed " : " run ") << result.m_seed << ": "
+                  << (result.m_valid ? "valid" : "invalid") << " in "
+                  << result.m_times.m_total << " ms" << std::endl;
+      }
+    }
+  }
+
+  std::ofstream file(options.m_output, std::ios::trunc);
+  if (!file.is_open())
+  {
+    std::cerr << "Could not open " << options.m_output << std::endl;
+    return 1;
+  }
+  writeResults(file, results, options.m_deterministic);
+  return 0;
+}
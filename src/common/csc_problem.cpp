@@ -13,10 +13,11 @@ adjacency_list_t majorminer::extractSubgraph(const EmbeddingBase& base, fuint32_
   adjacency_list_t subgraph{};
   const auto& targetGraph = *base.getTargetGraph();
   base.iterateSourceMappingPair(sourceNode,
-    [&subgraph, &targetGraph](fuint32_t targetNodeA, fuint32_t targetNodeB){
+    [&subgraph, &targetGraph, &base](fuint32_t targetNodeA, fuint32_t targetNodeB){
       edge_t uv{targetNodeA, targetNodeB};
       edge_t vu{targetNodeB, targetNodeA};
-      if (targetGraph.contains(uv) || targetGraph.contains(vu))
+      if ((targetGraph.contains(uv) || targetGraph.contains(vu))
+        && base.isTargetEdgeActive(targetNodeA, targetNodeB))
       {
         subgraph.insert(uv);
         subgraph.insert(vu);
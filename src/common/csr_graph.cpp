@@ -0,0 +1,122 @@
+#include <common/csr_graph.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace majorminer;
+
+namespace
+{
+  struct OwnedArrays
+  {
+    Vector<uint32_t> m_offsets;
+    Vector<uint32_t> m_adjacency;
+  };
+}
+
+
+CSRGraph::CSRGraph(Vector<uint32_t>&& offsets, Vector<uint32_t>&& adjacency)
+{
+  if (offsets.empty()) offsets.push_back(0);
+  auto arrays = std::make_shared<OwnedArrays>();
+  arrays->m_offsets = std::move(offsets);
+  arrays->m_adjacency = std::move(adjacency);
+  m_nbVertices = arrays->m_offsets.size() - 1;
+  m_offsets = arrays->m_offsets.data();
+  m_adjacency = arrays->m_adjacency.data();
+  m_storage = std::move(arrays);
+}
+
+CSRGraph::CSRGraph(std::shared_ptr<const void> storage, fuint32_t nbVertices,
+    const uint32_t* offsets, const uint32_t* adjacency)
+  : m_storage(std::move(storage)), m_nbVertices(nbVertices),
+    m_offsets(offsets), m_adjacency(adjacency) {}
+
+CSRGraph CSRGraph::fromEdgeList(const edge_list_t& edges, fuint32_t nbVertices)
+{
+  for (const auto& edge : edges)
+  {
+    nbVertices = std::max(nbVertices, std::max(edge.first, edge.second) + 1);
+  }
+  if (2 * edges.size() > UINT32_MAX) throw std::runtime_error("Graph too large for CSR.");
+
+  Vector<uint32_t> offsets(nbVertices + 1, 0);
+  for (const auto& edge : edges)
+  {
+    if (edge.first == edge.second) continue;
+    offsets[edge.first + 1]++;
+    offsets[edge.second + 1]++;
+  }
+  for (fuint32_t idx = 0; idx < nbVertices; ++idx) offsets[idx + 1] += offsets[idx];
+
+  Vector<uint32_t> adjacency(offsets[nbVertices]);
+  Vector<uint32_t> slots(offsets.begin(), offsets.end() - 1);
+  for (const auto& edge : edges)
+  {
+    if (edge.first == edge.second) continue;
+    adjacency[slots[edge.first]++] = edge.second;
+    adjacency[slots[edge.second]++] = edge.first;
+  }
+
+  // sort the rows and drop duplicate edges
+  tbb::parallel_for( tbb::blocked_range<fuint32_t>(0, nbVertices),
+    [&](const tbb::blocked_range<fuint32_t>& range) {
+      for (auto vertex = range.begin(); vertex != range.end(); ++vertex)
+      {
+        auto begin = adjacency.begin() + offsets[vertex];
+        auto end = adjacency.begin() + offsets[vertex + 1];
+        std::sort(begin, end);
+        slots[vertex] = std::unique(begin, end) - adjacency.begin();
+      }
+  });
+  uint32_t write = 0;
+  for (fuint32_t vertex = 0; vertex < nbVertices; ++vertex)
+  {
+    uint32_t start = offsets[vertex];
+    offsets[vertex] = write;
+    for (uint32_t idx = start; idx < slots[vertex]; ++idx) adjacency[write++] = adjacency[idx];
+  }
+  offsets[nbVertices] = write;
+  adjacency.resize(write);
+  return CSRGraph{std::move(offsets), std::move(adjacency)};
+}
+
+CSRGraph CSRGraph::fromGraph(const graph_t& graph)
+{
+  edge_list_t edges(graph.begin(), graph.end());
+  return fromEdgeList(edges);
+}
+
+bool CSRGraph::hasEdge(vertex_t u, vertex_t v) const
+{
+  if (u >= m_nbVertices) return false;
+  return std::binary_search(m_adjacency + m_offsets[u], m_adjacency + m_offsets[u + 1], v);
+}
+
+graph_t CSRGraph::toGraph() const
+{
+  graph_t graph{};
+  tbb::parallel_for( tbb::blocked_range<fuint32_t>(0, m_nbVertices),
+    [&](const tbb::blocked_range<fuint32_t>& range) {
+      for (auto vertex = range.begin(); vertex != range.end(); ++vertex)
+      {
+        iterateAdjacent(vertex, [&](vertex_t adjacent){
+          if (vertex < adjacent) graph.insert(std::make_pair(vertex, adjacent));
+        });
+      }
+  });
+  return graph;
+}
+
+edge_list_t CSRGraph::toEdgeList() const
+{
+  edge_list_t edges{};
+  edges.reserve(getNbEdges());
+  for (fuint32_t vertex = 0; vertex < m_nbVertices; ++vertex)
+  {
+    iterateAdjacent(vertex, [&](vertex_t adjacent){
+      if (vertex < adjacent) edges.push_back(std::make_pair(vertex, adjacent));
+    });
+  }
+  return edges;
+}
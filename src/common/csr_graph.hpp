@@ -0,0 +1,55 @@
+#ifndef __MAJORMINER_CSR_GRAPH_HPP_
+#define __MAJORMINER_CSR_GRAPH_HPP_
+
+#include <majorminer_types.hpp>
+
+namespace majorminer
+{
+
+  // Compressed sparse row adjacency of an undirected graph. Every edge is
+  // stored in both directions and the neighbors of a node are sorted. The
+  // arrays are either owned or point into a memory mapped file; copies share
+  // the same storage.
+  class CSRGraph
+  {
+    public:
+      CSRGraph() : m_nbVertices(0), m_offsets(nullptr), m_adjacency(nullptr) {}
+      CSRGraph(Vector<uint32_t>&& offsets, Vector<uint32_t>&& adjacency);
+      // Views the arrays of storage without copying them
+      CSRGraph(std::shared_ptr<const void> storage, fuint32_t nbVertices,
+        const uint32_t* offsets, const uint32_t* adjacency);
+
+      // Nodes without edges up to nbVertices are kept as isolated nodes
+      static CSRGraph fromEdgeList(const edge_list_t& edges, fuint32_t nbVertices = 0);
+      static CSRGraph fromGraph(const graph_t& graph);
+
+      fuint32_t getNbVertices() const { return m_nbVertices; }
+      fuint32_t getNbEdges() const { return m_nbVertices == 0 ? 0 : m_offsets[m_nbVertices] / 2; }
+      fuint32_t getDegree(vertex_t vertex) const { return m_offsets[vertex + 1] - m_offsets[vertex]; }
+      const uint32_t* getOffsets() const { return m_offsets; }
+      const uint32_t* getAdjacency() const { return m_adjacency; }
+
+      bool hasEdge(vertex_t u, vertex_t v) const;
+      graph_t toGraph() const;
+      edge_list_t toEdgeList() const;
+
+      template<typename Functor>
+      void iterateAdjacent(vertex_t vertex, Functor func) const
+      {
+        for (uint32_t idx = m_offsets[vertex]; idx < m_offsets[vertex + 1]; ++idx)
+        {
+          func(static_cast<vertex_t>(m_adjacency[idx]));
+        }
+      }
+
+    private:
+      std::shared_ptr<const void> m_storage;
+      fuint32_t m_nbVertices;
+      const uint32_t* m_offsets;
+      const uint32_t* m_adjacency;
+  };
+
+}
+
+
+#endif
@@ -129,7 +129,7 @@ bool majorminer::isCutVertex(const EmbeddingBase& base, nodeset_t& mappedNodes,
   auto range = targetAdj.equal_range(targetNode);
   for (auto it = range.first; it != range.second; ++it)
   {
-    if (mappedNodes.contains(it->second))
+    if (mappedNodes.contains(it->second) && base.isTargetEdgeActive(targetNode, it->second))
     {
       adjacentTarget = it->second;
       break;
@@ -147,8 +147,10 @@ bool majorminer::isCutVertex(const EmbeddingBase& base, nodeset_t& mappedNodes,
     else if (top.first->second == targetNode) top.first++;
     else
     {
+      vertex_t current = top.first->first;
       vertex_t next = top.first->second;
       top.first++;
+      if (!base.isTargetEdgeActive(current, next)) continue;
       auto val = mappedNodes.unsafe_extract(next);
       if (!val.empty())
       {
@@ -1,7 +1,40 @@
 #include "embedding_analyzer.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <tbb/parallel_sort.h>
+
+#include <common/csr_graph.hpp>
+
 using namespace majorminer;
 
+namespace
+{
+  template<typename T>
+  void writeArray(std::ostream& os, const Vector<T>& values)
+  {
+    os << "[";
+    for (size_t idx = 0; idx < values.size(); ++idx) os << (idx == 0 ? "" : ", ") << values[idx];
+    os << "]";
+  }
+
+  // smallest value such that at least the ratio of all entries is not larger
+  fuint32_t percentile(const Vector<fuint32_t>& histogram, fuint32_t total, double ratio)
+  {
+    fuint32_t rank = static_cast<fuint32_t>(std::ceil(ratio * total));
+    fuint32_t seen = 0;
+    for (fuint32_t value = 0; value < histogram.size(); ++value)
+    {
+      seen += histogram[value];
+      if (seen >= rank && seen > 0) return value;
+    }
+    return 0;
+  }
+}
+
 fuint32_t EmbeddingAnalyzer::getNbOverlaps() const
 {
   UnorderedMap<fuint32_t, fuint32_t> overlaps{};
@@ -25,4 +58,173 @@ fuint32_t EmbeddingAnalyzer::getNbUsedNodes() const
         targetNodes.insert(p.second);
   });
   return targetNodes.size();
-}
\ No newline at end of file
+}
+
+void EmbeddingAnalyzer::setRegions(fuint32_t nbRegions, std::function<fuint32_t(vertex_t)> region)
+{
+  m_nbRegions = std::max<fuint32_t>(nbRegions, 1);
+  m_region = std::move(region);
+}
+
+EmbeddingStatistics EmbeddingAnalyzer::analyze(fuint32_t nbHotspots) const
+{
+  EmbeddingStatistics stats{};
+  Vector<fuint32_pair_t> pairs(m_embedding.begin(), m_embedding.end());
+  tbb::parallel_sort(pairs.begin(), pairs.end());
+  pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+  CSRGraph source = m_source != nullptr ? CSRGraph::fromGraph(*m_source) : CSRGraph{};
+  CSRGraph target = m_target != nullptr ? CSRGraph::fromGraph(*m_target) : CSRGraph{};
+  fuint32_t nbSources = source.getNbVertices();
+  fuint32_t nbTargets = target.getNbVertices();
+  for (const auto& pair : pairs)
+  {
+    nbSources = std::max(nbSources, pair.first + 1);
+    nbTargets = std::max(nbTargets, pair.second + 1);
+  }
+
+  Vector<std::atomic<fuint32_t>> chainLengths(nbSources);
+  Vector<std::atomic<fuint32_t>> targetLoads(nbTargets);
+  tbb::parallel_for( tbb::blocked_range<size_t>(0, pairs.size()),
+    [&](const tbb::blocked_range<size_t>& range) {
+      for (auto idx = range.begin(); idx != range.end(); ++idx)
+      {
+        chainLengths[pairs[idx].first].fetch_add(1, std::memory_order_relaxed);
+        targetLoads[pairs[idx].second].fetch_add(1, std::memory_order_relaxed);
+      }
+  });
+
+  // chain lengths
+  fuint32_t totalLength = 0;
+  for (const auto& length : chainLengths)
+  {
+    fuint32_t value = length.load();
+    if (value == 0) continue;
+    if (value >= stats.m_chainLengths.size()) stats.m_chainLengths.resize(value + 1, 0);
+    stats.m_chainLengths[value]++;
+    stats.m_nbChains++;
+    stats.m_maxChainLength = std::max(stats.m_maxChainLength, value);
+    totalLength += value;
+  }
+  if (stats.m_nbChains > 0)
+  {
+    stats.m_meanChainLength = static_cast<double>(totalLength) / stats.m_nbChains;
+    stats.m_p95ChainLength = percentile(stats.m_chainLengths, stats.m_nbChains, 0.95);
+  }
+
+  // target usage, regions and hotspots
+  stats.m_regionSizes.assign(m_nbRegions, 0);
+  stats.m_regionUsed.assign(m_nbRegions, 0);
+  Vector<fuint32_pair_t> overlapped{};
+  for (vertex_t vertex = 0; vertex < nbTargets; ++vertex)
+  {
+    fuint32_t load = targetLoads[vertex].load();
+    bool exists = load > 0 || (vertex < target.getNbVertices() && target.getDegree(vertex) > 0);
+    if (!exists) continue;
+    fuint32_t region = m_region ? std::min(m_region(vertex), m_nbRegions - 1) : 0;
+    stats.m_regionSizes[region]++;
+    if (load == 0) continue;
+    stats.m_regionUsed[region]++;
+    stats.m_nbUsedTargets++;
+    if (load > 1) overlapped.push_back(std::make_pair(vertex, load));
+  }
+  stats.m_nbOverlappedTargets = overlapped.size();
+  auto byLoad = [](const fuint32_pair_t& a, const fuint32_pair_t& b){
+    return a.second > b.second || (a.second == b.second && a.first < b.first);
+  };
+  size_t nbKept = std::min<size_t>(nbHotspots, overlapped.size());
+  std::partial_sort(overlapped.begin(), overlapped.begin() + nbKept, overlapped.end(), byLoad);
+  stats.m_hotspots.assign(overlapped.begin(), overlapped.begin() + nbKept);
+
+  // couplers per logical edge, counted per source arc from the smaller vertex
+  stats.m_nbLogicalEdges = source.getNbEdges();
+  if (stats.m_nbLogicalEdges == 0) return stats;
+  Vector<fuint32_t> targetOffsets(nbTargets + 1, 0);
+  for (vertex_t vertex = 0; vertex < nbTargets; ++vertex) targetOffsets[vertex + 1] = targetOffsets[vertex] + targetLoads[vertex].load();
+  Vector<vertex_t> targetSources(pairs.size());
+  {
+    Vector<fuint32_t> slots(targetOffsets.begin(), targetOffsets.end() - 1);
+    for (const auto& pair : pairs) targetSources[slots[pair.second]++] = pair.first;
+  }
+  Vector<std::atomic<fuint32_t>> couplers(2 * source.getNbEdges());
+  tbb::parallel_for( tbb::blocked_range<fuint32_t>(0, target.getNbVertices()),
+    [&](const tbb::blocked_range<fuint32_t>& range) {
+      for (auto vertex = range.begin(); vertex != range.end(); ++vertex)
+      {
+        target.iterateAdjacent(vertex, [&](vertex_t adjacent){
+          if (adjacent < vertex) return;
+          for (fuint32_t idxA = targetOffsets[vertex]; idxA < targetOffsets[vertex + 1]; ++idxA)
+          {
+            for (fuint32_t idxB = targetOffsets[adjacent]; idxB < targetOffsets[adjacent + 1]; ++idxB)
+            {
+              vertex_t sourceA = std::min(targetSources[idxA], targetSources[idxB]);
+              vertex_t sourceB = std::max(targetSources[idxA], targetSources[idxB]);
+              if (sourceA == sourceB || sourceB >= source.getNbVertices()) continue;
+              const uint32_t* begin = source.getAdjacency() + source.getOffsets()[sourceA];
+              const uint32_t* end = source.getAdjacency() + source.getOffsets()[sourceA + 1];
+              const uint32_t* found = std::lower_bound(begin, end, sourceB);
+              if (found == end || *found != sourceB) continue;
+              couplers[found - source.getAdjacency()].fetch_add(1, std::memory_order_relaxed);
+            }
+          }
+        });
+      }
+  });
+
+  fuint32_t totalCouplers = 0;
+  for (vertex_t vertex = 0; vertex < source.getNbVertices(); ++vertex)
+  {
+    for (fuint32_t arc = source.getOffsets()[vertex]; arc < source.getOffsets()[vertex + 1]; ++arc)
+    {
+      if (source.getAdjacency()[arc] < vertex) continue;
+      fuint32_t value = couplers[arc].load();
+      if (value >= stats.m_couplers.size()) stats.m_couplers.resize(value + 1, 0);
+      stats.m_couplers[value]++;
+      stats.m_maxCouplers = std::max(stats.m_maxCouplers, value);
+      if (value == 0) stats.m_nbUncoupledEdges++;
+      totalCouplers += value;
+    }
+  }
+  stats.m_meanCouplers = static_cast<double>(totalCouplers) / stats.m_nbLogicalEdges;
+  return stats;
+}
+
+std::string EmbeddingStatistics::toJSON() const
+{
+  std::ostringstream os;
+  os << "{\n"
+     << "  \"chains\": " << m_nbChains << ",\n"
+     << "  \"usedTargets\": " << m_nbUsedTargets << ",\n"
+     << "  \"overlappedTargets\": " << m_nbOverlappedTargets << ",\n"
+     << "  \"chainLength\": { \"max\": " << m_maxChainLength
+     << ", \"mean\": " << m_meanChainLength
+     << ", \"p95\": " << m_p95ChainLength << ", \"histogram\": ";
+  writeArray(os, m_chainLengths);
+  os << " },\n"
+     << "  \"couplers\": { \"logicalEdges\": " << m_nbLogicalEdges
+     << ", \"uncoupled\": " << m_nbUncoupledEdges
+     << ", \"max\": " << m_maxCouplers
+     << ", \"mean\": " << m_meanCouplers << ", \"histogram\": ";
+  writeArray(os, m_couplers);
+  os << " },\n"
+     << "  \"regions\": { \"sizes\": ";
+  writeArray(os, m_regionSizes);
+  os << ", \"used\": ";
+  writeArray(os, m_regionUsed);
+  os << " },\n"
+     << "  \"hotspots\": [";
+  for (size_t idx = 0; idx < m_hotspots.size(); ++idx)
+  {
+    os << (idx == 0 ? "" : ", ") << "{ \"target\": " << m_hotspots[idx].first
+       << ", \"chains\": " << m_hotspots[idx].second << " }";
+  }
+  os << "]\n}\n";
+  return os.str();
+}
+
+void EmbeddingStatistics::exportJSON(const std::string& filename) const
+{
+  std::ofstream file(filename, std::ios::trunc);
+  if (!file.is_open()) throw std::runtime_error("Could not open file.");
+  file << toJSON();
+}
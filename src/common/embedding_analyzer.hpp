@@ -3,22 +3,70 @@
 
 #include "majorminer_types.hpp"
 
+#include <functional>
+
 namespace majorminer
 {
+  // Statistics of an embedding. Histograms are indexed by the value,
+  // e.g. m_chainLengths[3] is the number of chains with 3 target vertices.
+  struct EmbeddingStatistics
+  {
+    EmbeddingStatistics()
+      : m_nbChains(0), m_nbUsedTargets(0), m_nbOverlappedTargets(0),
+        m_maxChainLength(0), m_meanChainLength(0.0), m_p95ChainLength(0),
+        m_nbLogicalEdges(0), m_nbUncoupledEdges(0), m_maxCouplers(0), m_meanCouplers(0.0) {}
+
+    std::string toJSON() const;
+    void exportJSON(const std::string& filename) const;
+
+    fuint32_t m_nbChains;
+    fuint32_t m_nbUsedTargets;
+    fuint32_t m_nbOverlappedTargets;
+
+    fuint32_t m_maxChainLength;
+    double m_meanChainLength;
+    fuint32_t m_p95ChainLength;
+    Vector<fuint32_t> m_chainLengths;
+
+    // couplers are target edges between the chains of a logical (source) edge
+    fuint32_t m_nbLogicalEdges;
+    fuint32_t m_nbUncoupledEdges; // covered by a shared target vertex at most
+    fuint32_t m_maxCouplers;
+    double m_meanCouplers;
+    Vector<fuint32_t> m_couplers;
+
+    Vector<fuint32_t> m_regionSizes;
+    Vector<fuint32_t> m_regionUsed;
+    Vector<fuint32_pair_t> m_hotspots; // (target, number of chains), most loaded first
+  };
+
   class EmbeddingAnalyzer
   {
     public:
       EmbeddingAnalyzer(const embedding_mapping_t& emb)
-        : m_embedding(emb) { }
+        : m_embedding(emb), m_source(nullptr), m_target(nullptr), m_nbRegions(1) { }
+      EmbeddingAnalyzer(const embedding_mapping_t& emb, const graph_t& source, const graph_t& target)
+        : m_embedding(emb), m_source(&source), m_target(&target), m_nbRegions(1) { }
 
       fuint32_t getNbOverlaps() const;
       fuint32_t getNbUsedNodes() const;
 
+      // Target vertices are grouped into regions for the utilization, e.g.
+      // the unit cells of a Chimera graph. By default there is one region.
+      void setRegions(fuint32_t nbRegions, std::function<fuint32_t(vertex_t)> region);
+
+      // Edge and region statistics require the graphs
+      EmbeddingStatistics analyze(fuint32_t nbHotspots = 10) const;
+
 
     private:
       const embedding_mapping_t& m_embedding;
+      const graph_t* m_source;
+      const graph_t* m_target;
+      fuint32_t m_nbRegions;
+      std::function<fuint32_t(vertex_t)> m_region;
   };
 }
 
 
-#endif
\ No newline at end of file
+#endif
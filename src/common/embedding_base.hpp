@@ -2,6 +2,7 @@
 #define __MAJORMINER_EMBEDDING_BASE_HPP_
 
 #include <majorminer_types.hpp>
+#include <common/target_topology.hpp>
 
 namespace majorminer
 {
@@ -25,6 +26,22 @@ namespace majorminer
       bool isTargetNodeOccupied(vertex_t targetNode) const { return getRemainingTargetNodes().contains(targetNode); }
       virtual int numberFreeNeighborsNeeded(vertex_t sourceNode) const = 0;
 
+      // Inactive target vertices and edges, nullptr if the target has no defects.
+      // The iteration methods below skip them.
+      virtual const DefectMask* getDefectMask() const { return nullptr; }
+
+      bool isTargetVertexActive(vertex_t targetNode) const
+      {
+        const DefectMask* defects = getDefectMask();
+        return defects == nullptr || defects->isVertexActive(targetNode);
+      }
+
+      bool isTargetEdgeActive(vertex_t targetA, vertex_t targetB) const
+      {
+        const DefectMask* defects = getDefectMask();
+        return defects == nullptr || defects->isEdgeActive(targetA, targetB);
+      }
+
     // Iteration methods
     public:
 
@@ -40,6 +57,7 @@ namespace majorminer
         auto embeddedPathIt = getMapping().equal_range(sourceNode);
         const auto& target = getTargetAdjGraph();
         const auto& remaining = getRemainingTargetNodes();
+        const DefectMask* defects = getDefectMask();
 
         for (auto targetNode = embeddedPathIt.first; targetNode != embeddedPathIt.second; ++targetNode)
         {
@@ -48,6 +66,7 @@ namespace majorminer
           for (auto targetAdjacent = targetGraphAdjacentIt.first; targetAdjacent != targetGraphAdjacentIt.second; ++targetAdjacent)
           {
             if (skipOccupied && !remaining.contains(targetAdjacent->second)) continue;
+            if (defects != nullptr && !defects->isEdgeActive(targetNode->second, targetAdjacent->second)) continue;
             if (func(targetAdjacent->second, targetNode->second)) return;
           }
         }
@@ -72,6 +91,7 @@ namespace majorminer
         auto embeddedPathIt = getMapping().equal_range(sourceNode);
         const auto& target = getTargetAdjGraph();
         const auto& reverseMapping = getReverseMapping();
+        const DefectMask* defects = getDefectMask();
 
         for (auto mapIt = embeddedPathIt.first; mapIt != embeddedPathIt.second; ++mapIt)
         {
@@ -79,6 +99,7 @@ namespace majorminer
           auto targetGraphAdjacentIt = target.equal_range(mapIt->second);
           for (auto targetAdjacent = targetGraphAdjacentIt.first; targetAdjacent != targetGraphAdjacentIt.second; ++targetAdjacent)
           {
+            if (defects != nullptr && !defects->isEdgeActive(mapIt->second, targetAdjacent->second)) continue;
             auto revRange = reverseMapping.equal_range(targetAdjacent->second);
             for (auto revIt = revRange.first; revIt != revRange.second; ++revIt)
             {
@@ -91,9 +112,11 @@ namespace majorminer
       template<typename Functor>
       void iterateTargetGraphAdjacent(vertex_t targetNode, Functor func) const
       {
+        const DefectMask* defects = getDefectMask();
         auto adjRange = getTargetAdjGraph().equal_range(targetNode);
         for (auto adj = adjRange.first; adj != adjRange.second; ++adj)
         {
+          if (defects != nullptr && !defects->isEdgeActive(targetNode, adj->second)) continue;
           func(adj->second);
         }
       }
@@ -121,9 +144,11 @@ namespace majorminer
       template<typename Functor>
       void iterateTargetGraphAdjacentBreak(vertex_t targetNode, Functor func) const
       {
+        const DefectMask* defects = getDefectMask();
         auto adjRange = getTargetAdjGraph().equal_range(targetNode);
         for (auto adj = adjRange.first; adj != adjRange.second; ++adj)
         {
+          if (defects != nullptr && !defects->isEdgeActive(targetNode, adj->second)) continue;
           if (func(adj->second)) return;
         }
       }
@@ -133,9 +158,11 @@ namespace majorminer
       {
         const auto& targetGraph = getTargetAdjGraph();
         const auto& reverse = getReverseMapping();
+        const DefectMask* defects = getDefectMask();
         auto adjacentRange = targetGraph.equal_range(target);
         for (auto adjIt = adjacentRange.first; adjIt != adjacentRange.second; ++adjIt)
         {
+          if (defects != nullptr && !defects->isEdgeActive(target, adjIt->second)) continue;
           auto revMappedRange = reverse.equal_range(adjIt->second);
           for (auto revIt = revMappedRange.first; revIt != revMappedRange.second; ++revIt)
           {
@@ -180,9 +207,11 @@ namespace majorminer
       {
         const auto& remaining = getRemainingTargetNodes();
         const auto& targetGraph = getTargetAdjGraph();
+        const DefectMask* defects = getDefectMask();
         auto range = targetGraph.equal_range(targetVertex);
         for (auto it = range.first; it != range.second; ++it)
         {
+          if (defects != nullptr && !defects->isEdgeActive(targetVertex, it->second)) continue;
           if (remaining.contains(it->second)) func(it->second);
         }
       }
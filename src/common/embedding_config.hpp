@@ -0,0 +1,81 @@
+#ifndef __MAJORMINER_EMBEDDING_CONFIG_HPP_
+#define __MAJORMINER_EMBEDDING_CONFIG_HPP_
+
+#include <majorminer_types.hpp>
+
+namespace majorminer
+{
+
+  // Costs of taking a target vertex in the placement flow network.
+  // An occupied vertex costs occupiedCost * overlapBase^(overlaps - 1)
+  // plus chainLengthWeight * (length of the longest chain on the vertex).
+  struct PlacementCostConfig
+  {
+    PlacementCostConfig()
+      : m_freeCost(1), m_occupiedCost(10), m_overlapBase(4.0),
+        m_chainLengthWeight(1.0), m_maxCost(10000) {}
+
+    int m_freeCost;
+    int m_occupiedCost;
+    double m_overlapBase;
+    double m_chainLengthWeight;
+    int m_maxCost;
+  };
+
+  // Parameters of the EvolutionaryCSCReducer. A budget of 0 means unlimited.
+  struct EvolutionaryConfig
+  {
+    EvolutionaryConfig()
+      : m_populationSize(5), m_eliteSize(3), m_iterationLimit(10),
+        m_maxNewVertices(15), m_reduceIterationCoefficient(1),
+        m_replaceIterations(5), m_timeBudgetMs(0), m_evaluationBudget(0),
+        m_regionRadius(8), m_maxRegionSize(2048) {}
+
+    fuint32_t m_populationSize;
+    fuint32_t m_eliteSize;
+    fuint32_t m_iterationLimit;
+    fuint32_t m_maxNewVertices;
+    fuint32_t m_reduceIterationCoefficient;
+    fuint32_t m_replaceIterations; // iterations of SuperVertexPlacer::replaceOverlapping
+    fuint32_t m_timeBudgetMs;
+    fuint32_t m_evaluationBudget;  // number of individuals optimized per reducer
+    fuint32_t m_regionRadius;      // free target vertices around the initial super vertex
+    fuint32_t m_maxRegionSize;     // the reducer may use
+  };
+
+  // Parameters of the LMRP repair phase. It only runs if a subgraph
+  // generator was set (EmbeddingSuite::setSubgraphGen). Craters are placed at
+  // overlap hotspots first. With adaptive craters the crater size grows if
+  // few repairs are accepted and shrinks if solving a crater takes too long.
+  struct LMRPConfig
+  {
+    LMRPConfig()
+      : m_rounds(3), m_adaptiveCraters(true), m_maxCraterGrowth(2),
+        m_lowAcceptance(0.2), m_highAcceptance(0.6), m_craterTimeBudgetMs(50.0) {}
+
+    fuint32_t m_rounds; // rounds of claiming and repairing craters
+    bool m_adaptiveCraters;
+    fuint32_t m_maxCraterGrowth; // above the initial crater size of the generator
+    double m_lowAcceptance;      // ratio of applied repairs per solved crater
+    double m_highAcceptance;
+    double m_craterTimeBudgetMs; // average solve time of a crater, unused if deterministic
+  };
+
+  struct EmbeddingConfig
+  {
+    EmbeddingConfig() : m_deterministic(false), m_seed(0) {}
+
+    // If set, every random decision is drawn from a stream derived from m_seed
+    // and mutations are committed in a fixed order, so runs can be replayed.
+    bool m_deterministic;
+    uint64_t m_seed;
+
+    PlacementCostConfig m_placementCosts;
+    EvolutionaryConfig m_evolutionary;
+    LMRPConfig m_lmrp;
+  };
+
+}
+
+
+#endif
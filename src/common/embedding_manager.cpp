@@ -2,6 +2,7 @@
 
 #include <common/utils.hpp>
 #include <common/embedding_state.hpp>
+#include <common/embedding_trace.hpp>
 
 #define CACHE_CAPACITY 128
 
@@ -123,14 +124,19 @@ void EmbeddingManager::synchronize()
   auto& sourceFreeNeighbors = m_state.getSourceFreeNeighbors();
   auto& nodesOccupied = m_state.getNodesOccupied();
   auto& targetNodesRemaining = m_state.getRemainingTargetNodes();
+  auto& tracker = m_state.getValidityTracker();
+  EmbeddingTrace* trace = m_state.getTrace();
+  PROFILE_SCOPE(m_state.getProfiler(), "synchronize")
   while(!m_changesToPropagate.empty() && m_nbCommitsRemaining > 0)
   {
     bool success = m_changesToPropagate.try_pop(change);
     if (!success) break;
+    if (trace != nullptr) trace->recordChange(change);
     switch(change.m_type)
     {
       case ChangeType::DEL_MAPPING:
       {
+        if (containsPair(mapping, change.m_a, change.m_b)) tracker.erasePair(change.m_a, change.m_b);
         eraseSinglePair(mapping, change.m_a, change.m_b);
         eraseSinglePair(revMapping, change.m_b, change.m_a);
         m_changeHistory[change.m_a].m_timestampNodeChanged = m_time.load();
@@ -140,6 +146,7 @@ void EmbeddingManager::synchronize()
       {
         mapping.insert(std::make_pair(change.m_a, change.m_b));
         revMapping.insert(std::make_pair(change.m_b, change.m_a));
+        tracker.insertPair(change.m_a, change.m_b);
         m_changeHistory[change.m_a].m_timestampNodeChanged = m_time.load();
         break;
       }
@@ -195,9 +202,10 @@ ShiftingCandidates EmbeddingManager::setCandidatesFor(fuint32_t conquerorNode, n
 {
   fuint32_t size = candidates.size();
   ShiftingCandidates element = std::make_pair(size, majorminer::make_shared_array<fuint32_pair_t>(size));
-  m_random.shuffle(element.second.get(), size);
   fuint32_pair_t* writePtr = element.second.get();
   for (const auto& candidate : candidates) *writePtr++ = candidate;
+  RandomGen random{m_state.getTaskSeed(RandomStream::FRONTIER_CANDIDATES, deriveSeed(conquerorNode, size))};
+  random.shuffle(element.second.get(), size);
   m_candidateCache[conquerorNode].value() = element;
   return element;
 }
@@ -215,5 +223,6 @@ const embedding_mapping_t& EmbeddingManager::getMapping() const { return m_mappi
 const embedding_mapping_t& EmbeddingManager::getReverseMapping() const { return m_reverseMapping; }
 const nodeset_t& EmbeddingManager::getNodesOccupied() const { return m_nodesOccupied; }
 const nodeset_t& EmbeddingManager::getRemainingTargetNodes() const { return m_targetNodesRemaining; }
+const DefectMask* EmbeddingManager::getDefectMask() const { return m_state.getDefectMask(); }
 
 
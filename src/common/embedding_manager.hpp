@@ -72,8 +72,6 @@ namespace majorminer
       ShiftingCandidates getCandidatesFor(vertex_t conquerorNode);
       ShiftingCandidates setCandidatesFor(vertex_t conquerorNode, nodepairset_t& candidates);
 
-      RandomGen& getRandomGen() { return m_random; }
-
       EmbeddingVisualizer* getVisualizer();
 
     public:
@@ -85,6 +83,7 @@ namespace majorminer
       const embedding_mapping_t& getReverseMapping() const override;
       const nodeset_t& getNodesOccupied() const override;
       const nodeset_t& getRemainingTargetNodes() const override;
+      const DefectMask* getDefectMask() const override;
 
 
     private:
@@ -97,7 +96,6 @@ namespace majorminer
       EmbeddingSuite& m_suite;
       EmbeddingState& m_state;
       CandidateCache m_candidateCache;
-      RandomGen m_random;
 
       embedding_mapping_t m_mapping;
       embedding_mapping_t m_reverseMapping;
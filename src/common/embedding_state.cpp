@@ -1,11 +1,21 @@
 #include "embedding_state.hpp"
 
 #include "common/utils.hpp"
+#include "common/embedding_trace.hpp"
 
 using namespace majorminer;
 
 EmbeddingState::EmbeddingState(const graph_t& sourceGraph, const graph_t& targetGraph, EmbeddingVisualizer* vis)
-  : m_sourceGraph(&sourceGraph), m_targetGraph(&targetGraph), m_visualizer(vis)
+  : m_sourceGraph(&sourceGraph), m_targetGraph(&targetGraph), m_target(&m_ownedTarget),
+    m_topology(nullptr), m_defects(nullptr), m_visualizer(vis), m_trace(nullptr), m_lmrpGen(nullptr), m_tracker(*this)
+{
+  initialize();
+}
+
+EmbeddingState::EmbeddingState(const graph_t& sourceGraph, const TargetTopology& topology,
+    const DefectMask* defects, EmbeddingVisualizer* vis)
+  : m_sourceGraph(&sourceGraph), m_targetGraph(&topology.getGraph()), m_target(&topology.getAdjacency()),
+    m_topology(&topology), m_defects(defects), m_visualizer(vis), m_trace(nullptr), m_lmrpGen(nullptr), m_tracker(*this)
 {
   initialize();
 }
@@ -13,11 +23,21 @@ EmbeddingState::EmbeddingState(const graph_t& sourceGraph, const graph_t& target
 void EmbeddingState::initialize()
 {
   convertToAdjacencyList(m_source, *m_sourceGraph);
-  convertToAdjacencyList(m_target, *m_targetGraph);
-  for (const auto& arc : *m_targetGraph)
+  if (m_topology == nullptr)
   {
-    m_targetNodesRemaining.insert(arc.first);
-    m_targetNodesRemaining.insert(arc.second);
+    convertToAdjacencyList(m_ownedTarget, *m_targetGraph);
+    for (const auto& arc : *m_targetGraph)
+    {
+      m_targetNodesRemaining.insert(arc.first);
+      m_targetNodesRemaining.insert(arc.second);
+    }
+  }
+  else
+  { // inactive vertices are never free, so they are never placed on
+    for (vertex_t target : m_topology->getVertices())
+    {
+      if (isTargetVertexActive(target)) m_targetNodesRemaining.insert(target);
+    }
   }
   for (const auto& arc : *m_sourceGraph)
   {
@@ -27,6 +47,13 @@ void EmbeddingState::initialize()
     m_sourceNeededNeighbors[arc.second]++;
   }
   m_numberSourceVertices = m_nodesRemaining.size();
+  m_tracker.initialize();
+}
+
+uint64_t EmbeddingState::getTaskSeed(RandomStream stream, uint64_t task) const
+{
+  if (!m_config.m_deterministic) return nextStreamSeed();
+  return deriveSeed(deriveSeed(m_config.m_seed, stream), task);
 }
 
 fuint32_t EmbeddingState::getTrivialNode()
@@ -47,6 +74,11 @@ void EmbeddingState::unmapNode(vertex_t sourceVertex)
 {
   auto range = m_mapping.equal_range(sourceVertex);
   for (auto mappedIt = range.first; mappedIt != range.second; ++mappedIt)
+  {
+    m_tracker.erasePair(sourceVertex, mappedIt->second);
+    if (m_trace != nullptr) m_trace->recordChange(EmbeddingChange{ChangeType::DEL_MAPPING, sourceVertex, mappedIt->second});
+  }
+  for (auto mappedIt = range.first; mappedIt != range.second; ++mappedIt)
   {
     eraseSinglePair(m_reverseMapping, mappedIt->second, mappedIt->first);
   }
@@ -99,7 +131,13 @@ void EmbeddingState::mapNode(fuint32_t source, fuint32_t targetNode)
   m_mapping.insert(std::make_pair(source, targetNode));
   m_reverseMapping.insert(std::make_pair(targetNode, source));
   m_targetNodesRemaining.unsafe_extract(targetNode);
+  m_tracker.insertPair(source, targetNode);
   removeRemainingNode(source);
+  if (m_trace != nullptr)
+  {
+    m_trace->recordChange(EmbeddingChange{ChangeType::INS_MAPPING, source, targetNode});
+    m_trace->recordChange(EmbeddingChange{});
+  }
 }
 
 void EmbeddingState::mapNode(fuint32_t source, const nodeset_t& targets)
@@ -110,7 +148,10 @@ void EmbeddingState::mapNode(fuint32_t source, const nodeset_t& targets)
     m_mapping.insert(std::make_pair(source, targetNode));
     m_reverseMapping.insert(std::make_pair(targetNode, source));
     m_targetNodesRemaining.unsafe_extract(targetNode);
+    m_tracker.insertPair(source, targetNode);
+    if (m_trace != nullptr) m_trace->recordChange(EmbeddingChange{ChangeType::INS_MAPPING, source, targetNode});
   }
   removeRemainingNode(source);
+  if (m_trace != nullptr) m_trace->recordChange(EmbeddingChange{});
 }
 
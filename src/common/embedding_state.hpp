@@ -3,7 +3,11 @@
 
 #include <majorminer_types.hpp>
 #include <common/embedding_base.hpp>
+#include <common/embedding_config.hpp>
+#include <common/random_gen.hpp>
 #include <common/thread_manager.hpp>
+#include <common/time_measurement.hpp>
+#include <common/validity_tracker.hpp>
 #include <lmrp/lmrp_subgraph.hpp>
 
 namespace majorminer
@@ -14,9 +18,14 @@ namespace majorminer
     friend EmbeddingManager;
     public:
       EmbeddingState(const graph_t& sourceGraph, const graph_t& targetGraph, EmbeddingVisualizer* vis);
+      // Embeds into the active part of a cached topology. Both the topology
+      // and the defects have to outlive the state.
+      EmbeddingState(const graph_t& sourceGraph, const TargetTopology& topology,
+        const DefectMask* defects, EmbeddingVisualizer* vis);
 
       void mapNode(fuint32_t node, fuint32_t targetNode);
       void mapNode(fuint32_t source, const nodeset_t& targets);
+      void unmapNode(vertex_t sourceVertex);
       void updateNeededNeighbors(fuint32_t node);
       void updateConnections(fuint32_t node, PrioNodeQueue& nodesToProcess);
       int numberFreeNeighborsNeeded(fuint32_t sourceNode) const;
@@ -33,16 +42,26 @@ namespace majorminer
 
       ThreadManager& getThreadManager() { return m_threadManager; }
       void setLMRPSubgraphGenerator(LMRPSubgraph* gen) { m_lmrpGen = gen; }
+      void setConfig(const EmbeddingConfig& config) { m_config = config; }
+      const EmbeddingConfig& getConfig() const { return m_config; }
+      bool isDeterministic() const { return m_config.m_deterministic; }
+      uint64_t getTaskSeed(RandomStream stream, uint64_t task) const;
+      ValidityTracker& getValidityTracker() { return m_tracker; }
+      void setTrace(EmbeddingTrace* trace) { m_trace = trace; }
+      EmbeddingTrace* getTrace() { return m_trace; }
+      Profiler& getProfiler() { return m_profiler; }
+      const Profiler& getProfiler() const { return m_profiler; }
 
     public: // getter
       const graph_t* getSourceGraph() const override { return m_sourceGraph; }
       const graph_t* getTargetGraph() const override { return m_targetGraph; }
       const adjacency_list_t& getSourceAdjGraph() const override { return m_source; }
-      const adjacency_list_t& getTargetAdjGraph() const override { return m_target; }
+      const adjacency_list_t& getTargetAdjGraph() const override { return *m_target; }
       const embedding_mapping_t& getMapping() const override { return m_mapping; }
       const embedding_mapping_t& getReverseMapping() const override { return m_reverseMapping; }
       const nodeset_t& getNodesOccupied() const override { return m_nodesOccupied; }
       const nodeset_t& getRemainingTargetNodes() const override { return m_targetNodesRemaining; }
+      const DefectMask* getDefectMask() const override { return m_defects; }
 
 
       embedding_mapping_t& getMapping() { return m_mapping; }
@@ -64,13 +83,15 @@ namespace majorminer
 
     private:
       void initialize();
-      void unmapNode(vertex_t sourceVertex);
 
     private:
       const graph_t* m_sourceGraph;
       const graph_t* m_targetGraph;
       adjacency_list_t m_source;
-      adjacency_list_t m_target;
+      const adjacency_list_t* m_target;
+      adjacency_list_t m_ownedTarget;
+      const TargetTopology* m_topology;
+      const DefectMask* m_defects;
 
       embedding_mapping_t m_mapping;
       embedding_mapping_t m_reverseMapping;
@@ -84,10 +105,14 @@ namespace majorminer
       fuint32_t m_numberSourceVertices;
 
       EmbeddingVisualizer* m_visualizer;
+      EmbeddingTrace* m_trace;
 
       LMRPSubgraph* m_lmrpGen;
+      EmbeddingConfig m_config;
+      ValidityTracker m_tracker;
 
       ThreadManager m_threadManager;
+      Profiler m_profiler;
   };
 
 }
@@ -0,0 +1,236 @@
+#include "embedding_trace.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+
+#include <common/utils.hpp>
+#include <common/embedding_visualizer.hpp>
+
+using namespace majorminer;
+namespace fs = std::filesystem;
+
+namespace
+{
+  const char TRACE_MAGIC[8] = { 'M', 'M', 'T', 'R', 'A', 'C', 'E', 0 };
+  const uint32_t TRACE_VERSION = 1;
+  const size_t TRACE_BUFFER_SIZE = 1 << 20;
+
+  fuint32_t getNbArguments(uint8_t type)
+  {
+    switch(type)
+    {
+      case ChangeType::COMMIT: return 0;
+      case ChangeType::OCCUPY_NODE: case ChangeType::FREE_NODE: return 1;
+      case ChangeType::DEL_MAPPING: case ChangeType::INS_MAPPING: case ChangeType::FREE_NEIGHBORS: return 2;
+      default: throw std::runtime_error("Invalid trace record.");
+    }
+  }
+
+  class TraceReader
+  {
+    public:
+      TraceReader(const Vector<char>& data) : m_data(data), m_pos(0) {}
+
+      bool atEnd() const { return m_pos >= m_data.size(); }
+
+      uint8_t readByte()
+      {
+        if (atEnd()) throw std::runtime_error("Truncated trace.");
+        return static_cast<uint8_t>(m_data[m_pos++]);
+      }
+
+      uint64_t readVarint()
+      {
+        uint64_t value = 0;
+        for (fuint32_t shift = 0; shift < 64; shift += 7)
+        {
+          uint8_t byte = readByte();
+          value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+          if ((byte & 0x80) == 0) return value;
+        }
+        throw std::runtime_error("Invalid trace record.");
+      }
+
+      void readGraph(graph_t& graph)
+      {
+        uint64_t nbEdges = readVarint();
+        for (uint64_t idx = 0; idx < nbEdges; ++idx)
+        {
+          fuint32_t u = readVarint();
+          fuint32_t v = readVarint();
+          graph.insert(std::make_pair(u, v));
+        }
+      }
+
+      std::string readString(size_t length)
+      {
+        if (length > m_data.size() - m_pos) throw std::runtime_error("Truncated trace.");
+        std::string value(m_data.data() + m_pos, length);
+        m_pos += length;
+        return value;
+      }
+
+    private:
+      const Vector<char>& m_data;
+      size_t m_pos;
+  };
+}
+
+EmbeddingTrace::EmbeddingTrace(const std::string& filename, const graph_t& source, const graph_t& target)
+{
+  fs::path path = filename;
+  if (path.has_parent_path()) fs::create_directories(path.parent_path());
+  m_file.open(filename, std::ios::binary | std::ios::trunc);
+  if (!m_file.is_open()) throw std::runtime_error("Could not open file for the embedding trace.");
+  m_buffer.reserve(TRACE_BUFFER_SIZE);
+  m_buffer.insert(m_buffer.end(), TRACE_MAGIC, TRACE_MAGIC + sizeof(TRACE_MAGIC));
+  writeVarint(TRACE_VERSION);
+  writeGraph(source);
+  writeGraph(target);
+}
+
+EmbeddingTrace::~EmbeddingTrace()
+{
+  flush();
+}
+
+void EmbeddingTrace::recordChange(const EmbeddingChange& change)
+{
+  std::lock_guard lock{m_mutex};
+  m_buffer.push_back(static_cast<char>(change.m_type));
+  fuint32_t nbArguments = getNbArguments(change.m_type);
+  if (nbArguments > 0) writeVarint(change.m_a);
+  if (nbArguments > 1) writeVarint(change.m_b);
+  flushIfFull();
+}
+
+void EmbeddingTrace::recordPhase(const std::string& label)
+{
+  std::lock_guard lock{m_mutex};
+  m_buffer.push_back(static_cast<char>(TRACE_PHASE_MARKER));
+  writeVarint(label.size());
+  m_buffer.insert(m_buffer.end(), label.begin(), label.end());
+  flushIfFull();
+}
+
+void EmbeddingTrace::flush()
+{
+  std::lock_guard lock{m_mutex};
+  m_file.write(m_buffer.data(), m_buffer.size());
+  m_file.flush();
+  m_buffer.clear();
+}
+
+void EmbeddingTrace::flushIfFull()
+{
+  if (m_buffer.size() < TRACE_BUFFER_SIZE) return;
+  m_file.write(m_buffer.data(), m_buffer.size());
+  m_buffer.clear();
+}
+
+void EmbeddingTrace::writeVarint(uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    m_buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  m_buffer.push_back(static_cast<char>(value));
+}
+
+void EmbeddingTrace::writeGraph(const graph_t& graph)
+{
+  writeVarint(graph.size());
+  for (const auto& edge : graph)
+  {
+    writeVarint(edge.first);
+    writeVarint(edge.second);
+  }
+}
+
+
+TraceReplay::TraceReplay(const std::string& filename)
+  : m_nbFrames(0)
+{
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) throw std::runtime_error("File not found.");
+  Vector<char> data(static_cast<size_t>(file.tellg()));
+  file.seekg(0, std::ios::beg);
+  file.read(data.data(), data.size());
+
+  TraceReader reader{data};
+  if (reader.readString(sizeof(TRACE_MAGIC)) != std::string(TRACE_MAGIC, sizeof(TRACE_MAGIC)))
+  {
+    throw std::runtime_error("Not an embedding trace.");
+  }
+  if (reader.readVarint() != TRACE_VERSION) throw std::runtime_error("Unsupported trace version.");
+  reader.readGraph(m_source);
+  reader.readGraph(m_target);
+
+  while (!reader.atEnd())
+  {
+    TraceRecord record{ reader.readByte(), FUINT32_UNDEF, FUINT32_UNDEF };
+    if (record.m_type == TRACE_PHASE_MARKER)
+    {
+      record.m_a = m_phases.size();
+      m_phases.push_back(reader.readString(reader.readVarint()));
+    }
+    else
+    {
+      fuint32_t nbArguments = getNbArguments(record.m_type);
+      if (nbArguments > 0) record.m_a = reader.readVarint();
+      if (nbArguments > 1) record.m_b = reader.readVarint();
+      if (record.m_type == ChangeType::COMMIT) m_nbFrames++;
+    }
+    m_records.push_back(record);
+  }
+}
+
+bool TraceReplay::apply(embedding_mapping_t& mapping, const TraceRecord& record)
+{
+  switch(record.m_type)
+  {
+    case ChangeType::INS_MAPPING:
+    {
+      mapping.insert(std::make_pair(record.m_a, record.m_b));
+      return false;
+    }
+    case ChangeType::DEL_MAPPING:
+    {
+      eraseSinglePair(mapping, record.m_a, record.m_b);
+      return false;
+    }
+    case ChangeType::COMMIT: return true;
+    default: return false;
+  }
+}
+
+embedding_mapping_t TraceReplay::getFrame(fuint32_t frame) const
+{
+  if (frame >= m_nbFrames) throw std::runtime_error("Frame not contained in the trace.");
+  embedding_mapping_t mapping{};
+  fuint32_t current = 0;
+  for (const auto& record : m_records)
+  {
+    if (apply(mapping, record) && current++ == frame) break;
+  }
+  return mapping;
+}
+
+fuint32_t TraceReplay::render(EmbeddingVisualizer& visualizer, fuint32_t everyNth) const
+{
+  everyNth = std::max<fuint32_t>(everyNth, 1);
+  fuint32_t nbDrawn = 0;
+  replay([&](fuint32_t frame, const embedding_mapping_t& mapping, const std::string& phase){
+    if (frame % everyNth != 0 && frame + 1 != m_nbFrames) return;
+    nbDrawn++;
+    std::stringstream title{};
+    if (!phase.empty()) title << phase << ", ";
+    title << "frame " << frame;
+    visualizer.draw(mapping, title.str().c_str(), true);
+  });
+  visualizer.flush();
+  return nbDrawn;
+}
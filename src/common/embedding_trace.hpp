@@ -0,0 +1,95 @@
+#ifndef __MAJORMINER_EMBEDDING_TRACE_HPP_
+#define __MAJORMINER_EMBEDDING_TRACE_HPP_
+
+#include <majorminer_types.hpp>
+#include <common/embedding_manager.hpp>
+
+#include <fstream>
+
+namespace majorminer
+{
+  // Marks the start of a phase, e.g. "placement" or "lmrp". Stored next to
+  // the change types in the type byte of a record.
+  const uint8_t TRACE_PHASE_MARKER = 0x80;
+
+  struct TraceRecord
+  {
+    uint8_t m_type;
+    fuint32_t m_a;
+    fuint32_t m_b;
+  };
+
+  // Appends every change applied to the embedding state to a binary log.
+  // The file starts with both graphs, followed by one record per change:
+  // the type byte and its arguments as variable length integers. Phase
+  // markers store a label. Records are buffered and written in blocks.
+  class EmbeddingTrace
+  {
+    public:
+      EmbeddingTrace(const std::string& filename, const graph_t& source, const graph_t& target);
+      ~EmbeddingTrace();
+
+      void recordChange(const EmbeddingChange& change);
+      void recordPhase(const std::string& label);
+      void flush();
+
+    private:
+      void writeVarint(uint64_t value);
+      void writeGraph(const graph_t& graph);
+      void flushIfFull();
+
+    private:
+      std::ofstream m_file;
+      Vector<char> m_buffer;
+      std::mutex m_mutex;
+  };
+
+  // Reads a trace written by EmbeddingTrace. A frame is the mapping after
+  // a commit record.
+  class TraceReplay
+  {
+    public:
+      TraceReplay(const std::string& filename);
+
+      const graph_t& getSourceGraph() const { return m_source; }
+      const graph_t& getTargetGraph() const { return m_target; }
+      fuint32_t getNbFrames() const { return m_nbFrames; }
+      const Vector<TraceRecord>& getRecords() const { return m_records; }
+
+      // Reconstructs the mapping after the given frame
+      embedding_mapping_t getFrame(fuint32_t frame) const;
+
+      // Calls func(frame, mapping, phase) for every frame in order
+      template<typename Functor>
+      void replay(Functor func) const
+      {
+        embedding_mapping_t mapping{};
+        const std::string* phase = &m_noPhase;
+        fuint32_t frame = 0;
+        for (const auto& record : m_records)
+        {
+          if (record.m_type == TRACE_PHASE_MARKER) phase = &m_phases[record.m_a];
+          else if (apply(mapping, record)) func(frame++, static_cast<const embedding_mapping_t&>(mapping), *phase);
+        }
+      }
+
+      // Draws every n-th frame and the last one, returns the number drawn
+      fuint32_t render(EmbeddingVisualizer& visualizer, fuint32_t everyNth = 1) const;
+
+    private:
+      // returns true at the end of a frame
+      static bool apply(embedding_mapping_t& mapping, const TraceRecord& record);
+
+    private:
+      graph_t m_source;
+      graph_t m_target;
+      Vector<TraceRecord> m_records;
+      Vector<std::string> m_phases;
+      fuint32_t m_nbFrames;
+      std::string m_noPhase;
+  };
+
+}
+
+
+#endif
@@ -2,83 +2,192 @@
 
 #include <common/utils.hpp>
 #include <common/embedding_state.hpp>
+#include <common/csr_graph.hpp>
+
+#include <tbb/parallel_sort.h>
 
 using namespace majorminer;
 
-bool EmbeddingValidator::isDisjoint() const
+namespace
 {
-  UnorderedSet<fuint32_t> nodesOccupied{};
-  const auto& embedding = m_state.getMapping();
-  for (const auto& mapped : embedding)
+  // Concurrent union-find over the (source, target) pairs of the mapping.
+  // Roots are always linked to the smaller index.
+  class ConcurrentUnionFind
   {
-    if (nodesOccupied.contains(mapped.second))
-    {
-      DEBUG(OUT_S << "Not an injective mapping." << std::endl;)
-      DEBUG(printOverlappings();)
-      return false;
-    }
-    nodesOccupied.insert(mapped.second);
-  }
-  return true;
-}
+    public:
+      ConcurrentUnionFind(fuint32_t size) : m_parent(size)
+      {
+        for (fuint32_t idx = 0; idx < size; ++idx) m_parent[idx].store(idx, std::memory_order_relaxed);
+      }
 
-void EmbeddingValidator::printOverlappings() const
-{
-  fuint32_pair_t stats = calculateOverlappingStats(m_state);
-  std::cout << "Overlapping statistics:"              << std::endl
-            << "Distinct overlaps: " << stats.first   << std::endl
-            << "Total overlapping: " << stats.second  << std::endl;
+      fuint32_t find(fuint32_t idx)
+      {
+        while (true)
+        {
+          fuint32_t parent = m_parent[idx].load(std::memory_order_relaxed);
+          if (parent == idx) return idx;
+          fuint32_t grandParent = m_parent[parent].load(std::memory_order_relaxed);
+          if (parent != grandParent) m_parent[idx].compare_exchange_weak(parent, grandParent);
+          idx = grandParent;
+        }
+      }
+
+      void unite(fuint32_t idxA, fuint32_t idxB)
+      {
+        while (true)
+        {
+          idxA = find(idxA);
+          idxB = find(idxB);
+          if (idxA == idxB) return;
+          if (idxA < idxB) std::swap(idxA, idxB);
+          fuint32_t expected = idxA;
+          if (m_parent[idxA].compare_exchange_strong(expected, idxB)) return;
+        }
+      }
+
+    private:
+      Vector<std::atomic<fuint32_t>> m_parent;
+  };
 }
 
-bool EmbeddingValidator::nodesConnected() const
+
+ValidationReport EmbeddingValidator::validate() const
 {
-  const auto& embedding = m_state.getMapping();
-  const auto& sourceGraph = *m_state.getSourceGraph();
-  UnorderedMultiMap<fuint32_t, fuint32_t> adjacencies{};
-  for (const auto& e : sourceGraph)
+  ValidationReport report{};
+  const auto& mapping = m_state.getMapping();
+  const auto& targetGraph = *m_state.getTargetGraph();
+  CSRGraph source = CSRGraph::fromGraph(*m_state.getSourceGraph());
+
+  // pairs sorted by source, the chain of a source vertex is contiguous
+  Vector<fuint32_pair_t> pairs(mapping.begin(), mapping.end());
+  tbb::parallel_sort(pairs.begin(), pairs.end());
+  pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+  fuint32_t nbSources = source.getNbVertices();
+  fuint32_t nbTargets = 0;
+  for (const auto& pair : pairs)
   {
-    adjacencies.insert(orderedPair(e));
+    nbSources = std::max(nbSources, pair.first + 1);
+    nbTargets = std::max(nbTargets, pair.second + 1);
   }
 
-  UnorderedMap<fuint32_t, std::atomic<bool>> adjacentNodes{};
-  auto groupIt = adjacencies.begin();
-
-  while(groupIt != adjacencies.end())
+  Vector<fuint32_t> chainOffsets(nbSources + 1, 0);
+  Vector<fuint32_t> targetOffsets(nbTargets + 1, 0);
+  for (const auto& pair : pairs)
   {
-    adjacentNodes.clear();
-    auto adjRange = adjacencies.equal_range(groupIt->first);
-    for (auto it = adjRange.first; it != adjRange.second; ++it)
-    {
-      adjacentNodes.insert(std::make_pair(it->second, false));
-    }
-    auto mappedRange = embedding.equal_range(groupIt->first);
-
-    // for each node in adjacentNodes search for adjacency to mappedNodes
-    tbb::parallel_for_each(mappedRange.first, mappedRange.second,
-      [&](fuint32_pair_t targetNodeP) {
-        m_state.iterateReverseMapping(targetNodeP.second, [&](fuint32_t reverse){
-          if (adjacentNodes.contains(reverse)) adjacentNodes[reverse] = true;
-        });
-
-        m_state.iterateTargetAdjacentReverseMapping(targetNodeP.second, [&](fuint32_t revSourceNode){
-          if (adjacentNodes.contains(revSourceNode)) adjacentNodes[revSourceNode] = true;
-        });
-    });
+    chainOffsets[pair.first + 1]++;
+    targetOffsets[pair.second + 1]++;
+  }
+  for (fuint32_t idx = 0; idx < nbSources; ++idx) chainOffsets[idx + 1] += chainOffsets[idx];
+  for (fuint32_t idx = 0; idx < nbTargets; ++idx)
+  {
+    fuint32_t count = targetOffsets[idx + 1];
+    if (count > 1) report.m_nbOverlappedTargets++;
+    if (count > 0 && !m_state.isTargetVertexActive(idx)) report.m_nbInactiveTargets++;
+    targetOffsets[idx + 1] += targetOffsets[idx];
+  }
+  // pair indices of each target vertex, ordered by source
+  Vector<fuint32_t> targetPairs(pairs.size());
+  {
+    Vector<fuint32_t> slots(targetOffsets.begin(), targetOffsets.end() - 1);
+    for (fuint32_t idx = 0; idx < pairs.size(); ++idx) targetPairs[slots[pairs[idx].second]++] = idx;
+  }
 
-    for (const auto& adjNode : adjacentNodes)
+  Vector<std::atomic<uint8_t>> covered(source.getNbVertices() == 0 ? 0 : source.getOffsets()[source.getNbVertices()]);
+  auto cover = [&](vertex_t sourceA, vertex_t sourceB) {
+    if (sourceA > sourceB) std::swap(sourceA, sourceB);
+    if (sourceB >= source.getNbVertices()) return;
+    const uint32_t* begin = source.getAdjacency() + source.getOffsets()[sourceA];
+    const uint32_t* end = source.getAdjacency() + source.getOffsets()[sourceA + 1];
+    const uint32_t* found = std::lower_bound(begin, end, sourceB);
+    if (found != end && *found == sourceB) covered[found - source.getAdjacency()].store(1, std::memory_order_relaxed);
+  };
+
+  // chains sharing a target vertex cover their source edge
+  tbb::parallel_for( tbb::blocked_range<fuint32_t>(0, nbTargets),
+    [&](const tbb::blocked_range<fuint32_t>& range) {
+      for (auto target = range.begin(); target != range.end(); ++target)
+      {
+        for (fuint32_t idxA = targetOffsets[target]; idxA < targetOffsets[target + 1]; ++idxA)
+        {
+          for (fuint32_t idxB = idxA + 1; idxB < targetOffsets[target + 1]; ++idxB)
+          {
+            cover(pairs[targetPairs[idxA]].first, pairs[targetPairs[idxB]].first);
+          }
+        }
+      }
+  });
+
+  // a target edge joins the chains of a source vertex mapped to both ends
+  // and covers the source edges between the chains on either end
+  ConcurrentUnionFind chains{(fuint32_t)pairs.size()};
+  tbb::parallel_for(targetGraph.range(), [&](const auto& range) {
+    for (const auto& edge : range)
     {
-      if (!adjNode.second)
+      if (edge.first >= nbTargets || edge.second >= nbTargets) continue;
+      if (!m_state.isTargetEdgeActive(edge.first, edge.second)) continue;
+      for (fuint32_t idxA = targetOffsets[edge.first]; idxA < targetOffsets[edge.first + 1]; ++idxA)
       {
-        DEBUG(OUT_S << "Not all edges embedded! Node " << adjNode.first << " is missing at least one edge." << std::endl;)
-        DEBUG(printMissingEdges(adjNode.first));
-        return false;
+        fuint32_t pairA = targetPairs[idxA];
+        for (fuint32_t idxB = targetOffsets[edge.second]; idxB < targetOffsets[edge.second + 1]; ++idxB)
+        {
+          fuint32_t pairB = targetPairs[idxB];
+          if (pairs[pairA].first == pairs[pairB].first) chains.unite(pairA, pairB);
+          else cover(pairs[pairA].first, pairs[pairB].first);
+        }
       }
     }
-    groupIt = adjRange.second;
-  }
+  });
 
-  return true;
+  std::atomic<fuint32_t> nbUnmapped{0}, nbDisconnected{0}, nbUncovered{0};
+  std::atomic<fuint32_t> firstUncovered{FUINT32_UNDEF};
+  tbb::parallel_for( tbb::blocked_range<fuint32_t>(0, nbSources),
+    [&](const tbb::blocked_range<fuint32_t>& range) {
+      for (auto vertex = range.begin(); vertex != range.end(); ++vertex)
+      {
+        fuint32_t chainBegin = chainOffsets[vertex];
+        fuint32_t chainEnd = chainOffsets[vertex + 1];
+        bool hasEdges = vertex < source.getNbVertices() && source.getDegree(vertex) > 0;
+        if (chainBegin == chainEnd && hasEdges) nbUnmapped++;
+        if (chainBegin != chainEnd)
+        {
+          fuint32_t root = chains.find(chainBegin);
+          for (fuint32_t idx = chainBegin + 1; idx < chainEnd; ++idx)
+          {
+            if (chains.find(idx) != root)
+            {
+              nbDisconnected++;
+              break;
+            }
+          }
+        }
+        if (!hasEdges) continue;
+        fuint32_t uncovered = 0;
+        for (fuint32_t arc = source.getOffsets()[vertex]; arc < source.getOffsets()[vertex + 1]; ++arc)
+        {
+          if (vertex < source.getAdjacency()[arc] && !covered[arc].load(std::memory_order_relaxed)) uncovered++;
+        }
+        if (uncovered > 0)
+        {
+          nbUncovered += uncovered;
+          fuint32_t first = firstUncovered.load();
+          while (vertex < first && !firstUncovered.compare_exchange_weak(first, vertex)) {}
+        }
+      }
+  });
+  report.m_nbUnmappedVertices = nbUnmapped.load();
+  report.m_nbDisconnectedChains = nbDisconnected.load();
+  report.m_nbUncoveredEdges = nbUncovered.load();
+  DEBUG(if (firstUncovered.load() != FUINT32_UNDEF) printMissingEdges(firstUncovered.load());)
+  DEBUG(if (!report.isDisjoint()) printOverlappings();)
+  return report;
+}
 
+void EmbeddingValidator::printOverlappings() const
+{
+  fuint32_pair_t stats = calculateOverlappingStats(m_state);
+  std::cout << "Overlapping statistics:"              << std::endl
+            << "Distinct overlaps: " << stats.first   << std::endl
+            << "Total overlapping: " << stats.second  << std::endl;
 }
 
 void EmbeddingValidator::printMissingEdges(fuint32_t node) const
@@ -6,15 +6,39 @@
 namespace majorminer
 {
 
+  // Result of a full validation. An embedding is valid if all counters are 0.
+  struct ValidationReport
+  {
+    ValidationReport()
+      : m_nbOverlappedTargets(0), m_nbInactiveTargets(0), m_nbUnmappedVertices(0),
+        m_nbDisconnectedChains(0), m_nbUncoveredEdges(0) {}
+
+    bool isDisjoint() const { return m_nbOverlappedTargets == 0; }
+    bool avoidsDefects() const { return m_nbInactiveTargets == 0; }
+    bool chainsConnected() const { return m_nbDisconnectedChains == 0; }
+    bool edgesCovered() const { return m_nbUnmappedVertices == 0 && m_nbUncoveredEdges == 0; }
+    bool isValid() const { return isDisjoint() && avoidsDefects() && chainsConnected() && edgesCovered(); }
+
+    fuint32_t m_nbOverlappedTargets; // target vertices with more than one source vertex
+    fuint32_t m_nbInactiveTargets;   // target vertices in use, but masked as defect
+    fuint32_t m_nbUnmappedVertices;  // source vertices without a chain
+    fuint32_t m_nbDisconnectedChains;
+    fuint32_t m_nbUncoveredEdges;    // source edges without a target edge between the chains
+  };
+
   class EmbeddingValidator
   {
     public:
       EmbeddingValidator(const EmbeddingState& state)
        : m_state(state) {}
 
-      bool isDisjoint() const;
-      bool nodesConnected() const;
-      bool isValid() const { return isDisjoint() && nodesConnected(); }
+      // Checks all properties in one parallel pass over flat arrays
+      ValidationReport validate() const;
+
+      bool isDisjoint() const { return validate().isDisjoint(); }
+      bool nodesConnected() const { return validate().edgesCovered(); }
+      bool avoidsDefects() const { return validate().avoidsDefects(); }
+      bool isValid() const { return validate().isValid(); }
 
     private:
       void printMissingEdges(vertex_t node) const;
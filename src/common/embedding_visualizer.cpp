@@ -33,83 +33,143 @@ const static fuint32_t nbColors = sizeof(colors)/sizeof(colors[0]);
 
 #define Y_OFFSET 100
 
-void EmbeddingVisualizer::setupDrawing(const embedding_mapping_t& embedding)
+EmbeddingVisualizer::~EmbeddingVisualizer()
 {
-  if (!m_initialized) initialize();
-
-  m_embedding = &embedding;
-  m_svg << m_prepared;
-
-  double fontSize = std::min(getWidth() / 30, 40.0);
-  double y = 50 + fontSize / 2.0;
-
-  std::stringstream titleText {};
-  titleText << "Iteration " << (m_iteration + 1) << ": ";
-  m_svg << "<text x=\"" << getRadius() << "\" y=\"" << y
-        << "\" font-size=\"" << fontSize
-        << "\">" << titleText.str();
+  stopWorker();
 }
 
-void EmbeddingVisualizer::draw(const embedding_mapping_t& embedding, const char* title)
+void EmbeddingVisualizer::setAsync(bool async, fuint32_t maxQueuedFrames)
 {
-  setupDrawing(embedding);
-  if (title != nullptr) m_svg << title;
-  finishDrawing();
+  flush();
+  stopWorker();
+  m_async = async;
+  m_maxQueued = std::max<fuint32_t>(maxQueuedFrames, 1);
+  if (!m_async) return;
+  // virtual calls are not allowed on the worker, the layout is prepared here
+  if (!m_initialized) initialize();
+  m_stopping = false;
+  m_worker = std::thread([this](){ runWorker(); });
 }
 
-void EmbeddingVisualizer::finishDrawing()
+void EmbeddingVisualizer::setSampling(fuint32_t everyNth, double maxFramesPerSecond)
 {
-  m_svg << "</text>";
-  drawInterChainConnections();
-  drawChains();
-  drawNodes();
-
-  m_svg << "</svg>";
-  writeToFile();
-  m_embedding = nullptr;
+  m_sampleEvery = std::max<fuint32_t>(everyNth, 1);
+  m_minInterval = std::chrono::steady_clock::duration{0};
+  if (maxFramesPerSecond > 0)
+  {
+    m_minInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / maxFramesPerSecond));
+  }
 }
 
-const std::string& EmbeddingVisualizer::getColor(fuint32_t node)
+bool EmbeddingVisualizer::acceptFrame()
 {
-  return colors[node % nbColors];
+  if ((m_nbRequested++ % m_sampleEvery) != 0) return false;
+  if (m_minInterval.count() == 0) return true;
+  auto now = std::chrono::steady_clock::now();
+  if (m_nbRequested > 1 && now - m_lastFrame < m_minInterval) return false;
+  m_lastFrame = now;
+  return true;
 }
 
+void EmbeddingVisualizer::draw(const embedding_mapping_t& embedding, const char* title, bool force)
+{
+  if (!force && !acceptFrame()) return;
+  submit(embedding, title != nullptr ? std::string(title) : std::string(), force);
+}
 
-// inefficient but who cares?
-void EmbeddingVisualizer::drawInterChainConnections()
+void EmbeddingVisualizer::submit(const embedding_mapping_t& embedding, std::string title, bool force)
 {
-  UnorderedMultiMap<fuint32_t, fuint32_t> reverseMapping{};
-  for (const auto& mapped : *m_embedding)
+  Frame frame{ Vector<fuint32_pair_t>(embedding.begin(), embedding.end()), std::move(title) };
+  if (!m_async)
   {
-    reverseMapping.insert(std::make_pair(mapped.second, mapped.first));
+    render(frame.m_mapping, frame.m_title);
+    return;
   }
-  std::string color = "red";
-  for (const auto& edge : m_target)
   {
-    auto uRev = reverseMapping.equal_range(edge.first);
-    if (uRev.first == uRev.second) continue;
-    auto vRev = reverseMapping.equal_range(edge.second);
-    if (vRev.first == vRev.second) continue;
-    bool found = false;
-    for (auto u = uRev.first; u != uRev.second && !found; ++u)
+    std::lock_guard lock{m_queueMutex};
+    if (m_queue.size() >= m_maxQueued && !force)
     {
-      for (auto v = vRev.first; v != vRev.second && !found; ++v)
-      { // does m_source contain a (u,v) or a (v,u) edge?
-        if (m_source.contains(edge_t {u->second, v->second}))
-        { drawEdge(edge, color, 3); found = true; }
-        else if (m_source.contains(edge_t {v->second, u->second}))
-        { drawEdge(edge, color, 3); found = true; }
+      m_nbDropped++;
+      return;
+    }
+    m_queue.push_back(std::move(frame));
+  }
+  m_queueChanged.notify_all();
+}
 
-      }
+void EmbeddingVisualizer::runWorker()
+{
+  std::unique_lock lock{m_queueMutex};
+  while (true)
+  {
+    m_queueChanged.wait(lock, [this](){ return m_stopping || !m_queue.empty(); });
+    if (m_queue.empty()) return;
+    Frame frame = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_nbRendering++;
+    lock.unlock();
+
+    try
+    {
+      render(frame.m_mapping, frame.m_title);
+    }
+    catch (const std::exception& e)
+    {
+      DEBUG(OUT_S << "Visualizer: " << e.what() << std::endl;)
+      m_nbDropped++;
     }
+
+    lock.lock();
+    m_nbRendering--;
+    m_queueChanged.notify_all();
   }
 }
 
+void EmbeddingVisualizer::flush()
+{
+  if (!m_worker.joinable()) return;
+  std::unique_lock lock{m_queueMutex};
+  m_queueChanged.wait(lock, [this](){ return m_queue.empty() && m_nbRendering == 0; });
+}
+
+void EmbeddingVisualizer::stopWorker()
+{
+  if (!m_worker.joinable()) return;
+  {
+    std::lock_guard lock{m_queueMutex};
+    m_stopping = true;
+  }
+  m_queueChanged.notify_all();
+  m_worker.join();
+}
+
+// Only non-virtual members are used from here on, so frames can be rendered
+// on the worker thread. Fragments of chains and target vertices are kept
+// from the previous frame and only formatted again if they changed.
+void EmbeddingVisualizer::render(Vector<fuint32_pair_t>& mapping, const std::string& title)
+{
+  if (!m_initialized) initialize();
+
+  std::sort(mapping.begin(), mapping.end());
+  mapping.erase(std::unique(mapping.begin(), mapping.end()), mapping.end());
+  updateChains(mapping);
+  updateNodes(mapping);
+  updateInterChainConnections();
+  writeToFile(title);
+}
+
+const std::string& EmbeddingVisualizer::getColor(fuint32_t node)
+{
+  return colors[node % nbColors];
+}
+
 void EmbeddingVisualizer::initialize()
 {
   fs::path path = m_filename;
   auto parent = path.parent_path();
   fs::create_directories(parent);
+  vertex_t maxTarget = 0;
   for (const auto& edge : m_target)
   {
     // initialize node positions
@@ -128,7 +188,17 @@ void EmbeddingVisualizer::initialize()
     fuint32_t size = m_edgeSamples.size();
     fuint32_t nbSamples = insertEdge(m_edgeSamples, edge);
     m_edgePtrs.insert(std::make_pair(edge, std::make_pair(size, nbSamples)));
+    m_targetEdges.push_back(edge);
+    maxTarget = std::max(maxTarget, std::max(edge.first, edge.second));
+  }
+  m_incidentEdges.resize(m_targetEdges.empty() ? 0 : maxTarget + 1);
+  for (fuint32_t idx = 0; idx < m_targetEdges.size(); ++idx)
+  {
+    m_incidentEdges[m_targetEdges[idx].first].push_back(idx);
+    m_incidentEdges[m_targetEdges[idx].second].push_back(idx);
   }
+  m_interChainSvg.resize(m_targetEdges.size());
+  m_targetFragments.resize(m_incidentEdges.size());
 
   auto width = getWidth();
   auto height = getHeight() + Y_OFFSET;
@@ -141,108 +211,199 @@ void EmbeddingVisualizer::initialize()
   std::string color = "black";
   for (const auto& edge : m_target)
   {
-    drawEdge(edge, color);
+    drawEdge(m_svg, edge, color);
   }
 
   double radius = getRadius();
   std::string none = "white";
   for (auto node : m_nodes)
   {
-    drawNode(node.first, radius, node.second, none);
+    drawNode(m_svg, node.first, radius, node.second, none);
   }
   m_prepared = m_svg.str();
   m_svg.str(std::string());
+  m_fontSize = std::min(getWidth() / 30, 40.0);
 
   m_initialized = true;
 }
 
-void EmbeddingVisualizer::drawChains()
+// The mapping is sorted by source vertex
+void EmbeddingVisualizer::updateChains(const Vector<fuint32_pair_t>& mapping)
 {
-  if (m_embedding->size() == 0) return;
-  auto groupIt = m_embedding->begin();
-
-  while(groupIt != m_embedding->end())
+  Vector<vertex_t> active{};
+  Vector<vertex_t> targets{};
+  for (size_t idx = 0; idx < mapping.size();)
   {
-    auto rangeIt = m_embedding->equal_range(groupIt->first);
-    const auto& color = m_sourceNodeColors[groupIt->first];
-    for (auto targetNodeIt = rangeIt.first; targetNodeIt != rangeIt.second; ++targetNodeIt)
+    vertex_t source = mapping[idx].first;
+    targets.clear();
+    for (; idx < mapping.size() && mapping[idx].first == source; ++idx) targets.push_back(mapping[idx].second);
+    active.push_back(source);
+    if (source >= m_chainFragments.size()) m_chainFragments.resize(source + 1);
+    auto& fragment = m_chainFragments[source];
+    if (fragment.m_targets == targets) continue;
+
+    // connections within the chain
+    std::stringstream svg{};
+    const auto& color = m_sourceNodeColors[source];
+    for (size_t idxA = 0; idxA < targets.size(); ++idxA)
     {
-      auto innerIt = targetNodeIt;
-      ++innerIt;
-      for(; innerIt != rangeIt.second; ++innerIt)
+      for (size_t idxB = idxA + 1; idxB < targets.size(); ++idxB)
       {
-        if (m_target.contains(edge_t{targetNodeIt->second, innerIt->second}))
-        { // connection within a chain, draw it
-          drawEdge(edge_t{targetNodeIt->second, innerIt->second}, color, getStrokeWidth());
+        if (m_target.contains(edge_t{targets[idxA], targets[idxB]}))
+        {
+          drawEdge(svg, edge_t{targets[idxA], targets[idxB]}, color, getStrokeWidth());
         }
-        else if (m_target.contains(edge_t{innerIt->second, targetNodeIt->second}))
-        { // connection within a chain, draw it
-          drawEdge(edge_t{innerIt->second, targetNodeIt->second}, color, getStrokeWidth());
+        else if (m_target.contains(edge_t{targets[idxB], targets[idxA]}))
+        {
+          drawEdge(svg, edge_t{targets[idxB], targets[idxA]}, color, getStrokeWidth());
         }
       }
     }
-    groupIt = rangeIt.second;
+    fragment.m_targets = targets;
+    fragment.m_svg = svg.str();
+  }
+  for (vertex_t source : m_activeSources)
+  {
+    if (m_chainFragments[source].m_targets.empty()) continue;
+    if (std::binary_search(active.begin(), active.end(), source)) continue;
+    m_chainFragments[source] = ChainFragment{};
   }
+  m_activeSources.swap(active);
 }
 
-
-void EmbeddingVisualizer::writeToFile()
+// Sorts the mapping by target vertex
+void EmbeddingVisualizer::updateNodes(Vector<fuint32_pair_t>& mapping)
 {
-  std::stringstream name;
-  name << m_filename << "_" << (++m_iteration) << ".svg";
-  std::ofstream f(name.str());
-  if (!f.is_open()) throw std::runtime_error("Could not open file for visualization of embedding.");
+  auto byTarget = [](const fuint32_pair_t& a, const fuint32_pair_t& b){
+    return a.second < b.second || (a.second == b.second && a.first < b.first);
+  };
+  std::sort(mapping.begin(), mapping.end(), byTarget);
 
-  f << m_svg.str();
+  fuint32_t maxLoad = 0;
+  for (size_t idx = 0; idx < mapping.size();)
+  {
+    size_t first = idx;
+    while (idx < mapping.size() && mapping[idx].second == mapping[first].second) idx++;
+    maxLoad = std::max<fuint32_t>(maxLoad, idx - first);
+  }
 
-  f.close();
-  m_svg.str(std::string());
+  Vector<vertex_t> active{};
+  Vector<vertex_t> sources{};
+  m_changedTargets.clear();
+  double radius = getRadius();
+  double sizeDelta = maxLoad == 0 ? 0 : (radius / (maxLoad * 2));
+  for (size_t idx = 0; idx < mapping.size();)
+  {
+    vertex_t target = mapping[idx].second;
+    sources.clear();
+    for (; idx < mapping.size() && mapping[idx].second == target; ++idx) sources.push_back(mapping[idx].first);
+    active.push_back(target);
+    if (target >= m_targetFragments.size()) m_targetFragments.resize(target + 1);
+    auto& fragment = m_targetFragments[target];
+    bool sourcesChanged = fragment.m_sources != sources;
+    // a single chain does not depend on the maximum load
+    if (!sourcesChanged && (sources.size() == 1 || fragment.m_maxLoad == maxLoad)) continue;
+
+    // the larger circles are drawn first, ids are node_<target>_<nb + 2>
+    std::stringstream svg{};
+    for (fuint32_t nb = sources.size(); nb-- > 0;)
+    {
+      vertex_t source = sources[sources.size() - 1 - nb];
+      drawNode(svg, target, radius + sizeDelta * nb, m_nodes[target], m_sourceNodeColors[source], nb + 2);
+    }
+    if (sourcesChanged) m_changedTargets.push_back(target);
+    fragment.m_sources = sources;
+    fragment.m_maxLoad = maxLoad;
+    fragment.m_svg = svg.str();
+  }
+  for (vertex_t target : m_activeTargets)
+  {
+    if (m_targetFragments[target].m_sources.empty()) continue;
+    if (std::binary_search(active.begin(), active.end(), target)) continue;
+    m_targetFragments[target] = NodeFragment{};
+    m_changedTargets.push_back(target);
+  }
+  m_activeTargets.swap(active);
 }
 
-void EmbeddingVisualizer::drawNodes()
+// A target edge connects two chains if the chains of its ends contain
+// adjacent source vertices. Only edges at changed target vertices are checked.
+void EmbeddingVisualizer::updateInterChainConnections()
 {
-  UnorderedMap<fuint32_t, fuint32_t> targetNodesUsed{};
-  fuint32_t maxVal = 0;
-  for (const auto& mapped : *m_embedding)
+  std::string color = "red";
+  auto getSources = [&](vertex_t target) -> const Vector<vertex_t>& {
+    static const Vector<vertex_t> none{};
+    return target < m_targetFragments.size() ? m_targetFragments[target].m_sources : none;
+  };
+  for (vertex_t target : m_changedTargets)
   {
-    targetNodesUsed[mapped.second]++;
-    maxVal = std::max(maxVal, targetNodesUsed[mapped.second]);
+    if (target >= m_incidentEdges.size()) continue;
+    for (fuint32_t edgeIdx : m_incidentEdges[target])
+    {
+      const edge_t& edge = m_targetEdges[edgeIdx];
+      bool connected = false;
+      for (vertex_t u : getSources(edge.first))
+      {
+        for (vertex_t v : getSources(edge.second))
+        {
+          connected = m_source.contains(edge_t{u, v}) || m_source.contains(edge_t{v, u});
+          if (connected) break;
+        }
+        if (connected) break;
+      }
+      auto& fragment = m_interChainSvg[edgeIdx];
+      if (!connected) fragment.clear();
+      else if (fragment.empty())
+      {
+        std::stringstream svg{};
+        drawEdge(svg, edge, color, 3);
+        fragment = svg.str();
+      }
+    }
   }
+}
 
-  if (maxVal == 0) return;
-
-  double sizeDelta = (getRadius() / (maxVal * 2));
+void EmbeddingVisualizer::writeToFile(const std::string& title)
+{
+  std::stringstream name;
+  name << m_filename << "_" << (++m_iteration) << ".svg";
+  std::ofstream f(name.str());
+  if (!f.is_open()) throw std::runtime_error("Could not open file for visualization of embedding.");
 
-  double radius = getRadius();
+  double y = 50 + m_fontSize / 2.0;
+  f << m_prepared;
+  f << "<text x=\"" << getRadius() << "\" y=\"" << y
+    << "\" font-size=\"" << m_fontSize
+    << "\">" << "Iteration " << m_iteration << ": " << title << "</text>";
+  for (const auto& fragment : m_interChainSvg) f << fragment;
+  for (vertex_t source : m_activeSources) f << m_chainFragments[source].m_svg;
+  for (vertex_t target : m_activeTargets) f << m_targetFragments[target].m_svg;
+  f << "</svg>";
 
-  for (const auto& mapped : *m_embedding)
-  {
-    auto it = targetNodesUsed.find(mapped.second);
-    drawNode(mapped.second, radius + sizeDelta * (--it->second), m_nodes[mapped.second], m_sourceNodeColors[mapped.first], it->second + 2);
-  }
+  f.close();
 }
 
-void EmbeddingVisualizer::drawNode(fuint32_t node, double radius, const Coordinate_t& coordinate, const std::string& color, fuint32_t n)
+void EmbeddingVisualizer::drawNode(std::ostream& os, fuint32_t node, double radius, const Coordinate_t& coordinate, const std::string& color, fuint32_t n)
 {
-  m_svg << "<circle id=\"node_" << node << "_" << n << "\" r=\"" << radius << "\" cx=\"" << coordinate.first
-         << "\" cy=\"" << (coordinate.second + Y_OFFSET) << "\" fill=\""
-         << color << "\" stroke=\"black\" />";
+  os << "<circle id=\"node_" << node << "_" << n << "\" r=\"" << radius << "\" cx=\"" << coordinate.first
+     << "\" cy=\"" << (coordinate.second + Y_OFFSET) << "\" fill=\""
+     << color << "\" stroke=\"black\" />";
 }
 
-void EmbeddingVisualizer::drawEdge(const edge_t& edge, const std::string& color, double stroke)
+void EmbeddingVisualizer::drawEdge(std::ostream& os, const edge_t& edge, const std::string& color, double stroke)
 {
   auto edgePtr = m_edgePtrs[edge];
   const auto& startPos = m_nodes[edge.first];
   const auto& endPos = m_nodes[edge.second];
   #define COORD(c) c.first << "," << (c.second + Y_OFFSET) << " "
-  m_svg << "<polyline points=\"" <<  COORD(startPos);
+  os << "<polyline points=\"" <<  COORD(startPos);
   for (fuint32_t i = edgePtr.first; i < (edgePtr.first + edgePtr.second); ++i)
   {
     const auto& coordinate = m_edgeSamples[i];
-    m_svg << COORD(coordinate);
+    os << COORD(coordinate);
   }
-  m_svg << COORD(endPos) << "\" fill=\"none\" stroke=\""
-        << color << "\" stroke-width=\"" << stroke << "\"/>";
+  os << COORD(endPos) << "\" fill=\"none\" stroke=\""
+     << color << "\" stroke-width=\"" << stroke << "\"/>";
 }
 
 
@@ -319,6 +480,34 @@ double KingsVisualizer::getHeight() const
 }
 
 
+fuint32_t PegasusVisualizer::insertEdge(Vector<Coordinate_t>& /* coords */, const edge_t& /* edge */)
+{
+  return 0;
+}
+
+Coordinate_t PegasusVisualizer::insertNode(fuint32_t v) const
+{
+  double nodeSize = getNodeSize();
+  fuint32_t u = m_graph.getU(v);
+  fuint32_t line = 12 * m_graph.getW(v) + m_graph.getK(v);
+  // horizontal qubits are moved by half a line to not cover vertical ones
+  double middle = 12 * m_graph.getZ(v) + m_graph.getShift(u, m_graph.getK(v)) + 6 + 0.5 * u;
+  double x = (u == 0) ? line : middle;
+  double y = (u == 0) ? middle : line;
+  return std::make_pair((1 + 2 * x) * nodeSize, (1 + 2 * y) * nodeSize);
+}
+
+double PegasusVisualizer::getWidth() const
+{
+  return ((3 + 24 * m_graph.getWidth()) * getNodeSize());
+}
+
+double PegasusVisualizer::getHeight() const
+{
+  return ((3 + 24 * m_graph.getHeight()) * getNodeSize());
+}
+
+
 fuint32_t GenericVisualizer::insertEdge(Vector<Coordinate_t>& /* coords */, const edge_t& /* edge */)
 {
   return 0;
@@ -2,20 +2,37 @@
 #define __MAJORMINER_EMBEDDING_VISUALIZER_HPP_
 
 #include "majorminer_types.hpp"
+#include <common/graph_info.hpp>
 
 #include <sstream>
+#include <deque>
+#include <chrono>
+#include <condition_variable>
 
 namespace majorminer
 {
   typedef std::pair<double, double> Coordinate_t;
   typedef UnorderedMap<fuint32_t, Coordinate_t> VisualizerNodeCoordinateMap;
 
+  // Writes one SVG file per drawn frame. In async mode draw() only copies
+  // the mapping and queues the frame; a background thread renders and writes
+  // it. Frames can be sampled to every n-th call or to a maximum frame rate.
   class EmbeddingVisualizer
   {
     public:
       EmbeddingVisualizer(const graph_t& source, const graph_t& target, std::string filename)
        : m_source(source), m_target(target), m_filename(filename), m_iteration(0) { }
-      virtual ~EmbeddingVisualizer() {}
+      virtual ~EmbeddingVisualizer();
+
+      // Frames beyond maxQueuedFrames are dropped instead of blocking the caller
+      void setAsync(bool async, fuint32_t maxQueuedFrames = 64);
+      // A maxFramesPerSecond of 0 means unlimited
+      void setSampling(fuint32_t everyNth, double maxFramesPerSecond = 0);
+      // Blocks until all queued frames are written
+      void flush();
+      fuint32_t getNbDroppedFrames() const { return m_nbDropped; }
+      // Frames passed to draw without force, before sampling
+      fuint32_t getNbRequestedFrames() const { return m_nbRequested; }
 
     protected:
       virtual fuint32_t insertEdge(Vector<Coordinate_t>& coords, const edge_t& edge) = 0;
@@ -28,42 +45,92 @@ namespace majorminer
       double getStrokeWidth() const { return 6; }
 
     private:
+      struct Frame
+      {
+        Vector<fuint32_pair_t> m_mapping;
+        std::string m_title;
+      };
+
+      // Cached SVG elements of a chain (its internal edges) and of a target
+      // vertex (the stacked circles of the chains on it)
+      struct ChainFragment
+      {
+        Vector<vertex_t> m_targets;
+        std::string m_svg;
+      };
+      struct NodeFragment
+      {
+        Vector<vertex_t> m_sources;
+        fuint32_t m_maxLoad = 0;
+        std::string m_svg;
+      };
+
       void initialize();
-      void writeToFile();
-      void setupDrawing(const embedding_mapping_t& embedding);
-      void finishDrawing();
-      void drawNode(fuint32_t node, double radius, const Coordinate_t& coordinate, const std::string& color, fuint32_t n = 0);
-      void drawEdge(const edge_t& edge, const std::string& color, double stroke = 1);
-      void drawChains();
-      void drawInterChainConnections();
-      void drawNodes();
+      bool acceptFrame();
+      void submit(const embedding_mapping_t& embedding, std::string title, bool force = false);
+      void render(Vector<fuint32_pair_t>& mapping, const std::string& title);
+      void runWorker();
+      void stopWorker();
+      void updateChains(const Vector<fuint32_pair_t>& mapping);
+      void updateNodes(Vector<fuint32_pair_t>& mapping);
+      void updateInterChainConnections();
+      void writeToFile(const std::string& title);
+      void drawNode(std::ostream& os, fuint32_t node, double radius, const Coordinate_t& coordinate, const std::string& color, fuint32_t n = 0);
+      void drawEdge(std::ostream& os, const edge_t& edge, const std::string& color, double stroke = 1);
       const std::string& getColor(fuint32_t node);
 
     public:
-      void draw(const embedding_mapping_t& embedding, const char* title = nullptr);
+      // Frames drawn with force are neither sampled nor dropped and do not
+      // count as requested frames
+      void draw(const embedding_mapping_t& embedding, const char* title = nullptr, bool force = false);
 
       template<typename Functor>
       void draw(const embedding_mapping_t& embedding, Functor textGen)
       {
-        setupDrawing(embedding);
-        textGen(m_svg);
-        finishDrawing();
+        if (!acceptFrame()) return;
+        std::stringstream title{};
+        textGen(title);
+        submit(embedding, title.str());
       }
 
     private:
       bool m_initialized = false;
       const graph_t& m_source;
       const graph_t& m_target;
-      const embedding_mapping_t* m_embedding; // temporary pointer to the embedding
       std::string m_filename;
       fuint32_t m_iteration;
       std::stringstream m_svg;
       std::string m_prepared;
+      double m_fontSize = 0;
+
+      fuint32_t m_sampleEvery = 1;
+      std::chrono::steady_clock::duration m_minInterval{0};
+      std::chrono::steady_clock::time_point m_lastFrame{};
+      fuint32_t m_nbRequested = 0;
+      std::atomic<fuint32_t> m_nbDropped{0};
+
+      bool m_async = false;
+      bool m_stopping = false;
+      fuint32_t m_maxQueued = 64;
+      std::deque<Frame> m_queue;
+      fuint32_t m_nbRendering = 0;
+      std::mutex m_queueMutex;
+      std::condition_variable m_queueChanged;
+      std::thread m_worker;
 
       UnorderedMap<edge_t, fuint32_pair_t, PairHashFunc<fuint32_t>> m_edgePtrs;
       Vector<Coordinate_t> m_edgeSamples;
       UnorderedMap<fuint32_t, std::string> m_sourceNodeColors;
 
+      Vector<edge_t> m_targetEdges;
+      Vector<Vector<fuint32_t>> m_incidentEdges; // indexed by target vertex
+      Vector<std::string> m_interChainSvg;       // indexed by target edge, empty if not drawn
+      Vector<ChainFragment> m_chainFragments;    // indexed by source vertex
+      Vector<NodeFragment> m_targetFragments;    // indexed by target vertex
+      Vector<vertex_t> m_activeSources;
+      Vector<vertex_t> m_activeTargets;
+      Vector<vertex_t> m_changedTargets;
+
     protected:
       VisualizerNodeCoordinateMap m_nodes;
   };
@@ -108,6 +175,25 @@ namespace majorminer
       fuint32_t m_nbCols;
   };
 
+  // Draws every qubit at the middle of its line. Vertical qubits (u = 0) lie
+  // in column 12w + k, horizontal ones in row 12w + k.
+  class PegasusVisualizer : public EmbeddingVisualizer
+  {
+    public:
+      PegasusVisualizer(const graph_t& source, const graph_t& target, std::string filename, fuint32_t m)
+        : EmbeddingVisualizer(source, target, std::move(filename)), m_graph(m) {}
+      ~PegasusVisualizer(){}
+
+    protected:
+      fuint32_t insertEdge(Vector<Coordinate_t>& coords, const edge_t& edge) override;
+      Coordinate_t insertNode(fuint32_t v) const override;
+      double getWidth() const override;
+      double getHeight() const override;
+
+    private:
+      PegasusGraphInfo m_graph;
+  };
+
   typedef UnorderedMap<fuint32_t, Coordinate_t> coordinate_map_t;
   class GenericVisualizer : public EmbeddingVisualizer
   {
@@ -4,11 +4,31 @@
 #include <string>
 #include <memory>
 #include <iostream>
+#include <cmath>
+#include <atomic>
 
 #include <common/random_gen.hpp>
+#include <common/graph_info.hpp>
+#include <common/graph_io.hpp>
 
 using namespace majorminer;
 
+namespace
+{
+  graph_t edgeListToGraph(const edge_list_t& edges)
+  {
+    graph_t graph{};
+    tbb::parallel_for( tbb::blocked_range<size_t>(0, edges.size()),
+      [&graph, &edges](const tbb::blocked_range<size_t>& range) {
+        for (auto idx = range.begin(); idx != range.end(); ++idx)
+        {
+          graph.insert(edges[idx]);
+        }
+    });
+    return graph;
+  }
+}
+
 graph_t majorminer::generate_chimera(fuint32_t rows, fuint32_t cols)
 {
   graph_t graph{};
@@ -58,6 +78,64 @@ graph_t majorminer::generate_chimera(fuint32_t rows, fuint32_t cols)
 }
 
 
+graph_t majorminer::generate_pegasus(fuint32_t m)
+{
+  graph_t graph{};
+  if (m < 2) return graph;
+  PegasusGraphInfo info{m};
+  tbb::parallel_for( tbb::blocked_range<vertex_t>(0, info.getNbVertices()),
+    [&graph, &info](const tbb::blocked_range<vertex_t>& range) {
+      for (auto vertex = range.begin(); vertex != range.end(); ++vertex)
+      {
+        if (!info.isFabric(vertex)) continue;
+        info.iterateNeighbors(vertex, [&](vertex_t adjacent){
+          if (vertex < adjacent) graph.insert(std::make_pair(vertex, adjacent));
+        });
+      }
+  });
+  return graph;
+}
+
+edge_list_t majorminer::generate_zephyr_edges(fuint32_t m, fuint32_t t)
+{
+  edge_list_t edges{};
+  if (m == 0 || t == 0) return edges;
+  ZephyrGraphInfo info{m, t};
+  fuint32_t nbVertices = info.getNbVertices();
+
+  // count the edges to larger neighbors, then fill the disjoint slots
+  Vector<fuint32_t> offsets(nbVertices + 1, 0);
+  tbb::parallel_for( tbb::blocked_range<vertex_t>(0, nbVertices),
+    [&offsets, &info](const tbb::blocked_range<vertex_t>& range) {
+      for (auto vertex = range.begin(); vertex != range.end(); ++vertex)
+      {
+        info.iterateNeighbors(vertex, [&](vertex_t adjacent){
+          if (vertex < adjacent) offsets[vertex + 1]++;
+        });
+      }
+  });
+  for (fuint32_t idx = 0; idx < nbVertices; ++idx) offsets[idx + 1] += offsets[idx];
+
+  edges.resize(offsets[nbVertices]);
+  tbb::parallel_for( tbb::blocked_range<vertex_t>(0, nbVertices),
+    [&offsets, &info, &edges](const tbb::blocked_range<vertex_t>& range) {
+      for (auto vertex = range.begin(); vertex != range.end(); ++vertex)
+      {
+        fuint32_t slot = offsets[vertex];
+        info.iterateNeighbors(vertex, [&](vertex_t adjacent){
+          if (vertex < adjacent) edges[slot++] = std::make_pair(vertex, adjacent);
+        });
+        std::sort(edges.begin() + offsets[vertex], edges.begin() + slot);
+      }
+  });
+  return edges;
+}
+
+graph_t majorminer::generate_zephyr(fuint32_t m, fuint32_t t)
+{
+  return edgeListToGraph(generate_zephyr_edges(m, t));
+}
+
 graph_t majorminer::generate_king(fuint32_t rows, fuint32_t cols)
 {
   graph_t graph{};
@@ -86,81 +164,12 @@ graph_t majorminer::generate_king(fuint32_t rows, fuint32_t cols)
 
 graph_t majorminer::import_graph(std::string filename)
 {
-  std::ifstream file(filename);
-  if (!file.is_open()) throw std::runtime_error("File not found.");
-
-  file.seekg(0, std::ios::end);
-  size_t length = file.tellg();
-
-  file.seekg(0, std::ios::beg);
-
-  auto content = std::make_unique<char[]>(length);
-  file.read(content.get(), length);
-  return import_graph(content.get(), length);
+  return edgeListToGraph(import_edge_list(filename));
 }
 
-enum ImportState
-{
-  INITIAL,
-  OUTER_LIST,
-  INNER_LIST
-};
-
 graph_t majorminer::import_graph(const char* edgeList, size_t length)
 {
-  graph_t graph{};
-  ImportState state = INITIAL;
-
-  fuint32_t readIdx = 0;
-  fuint32_t nodes[] = { 0, 0 };
-  fuint32_t nrEnds = 0;
-  fuint32_t currentVal = 0;
-  bool done = false;
-  bool readNb = false;
-  while(readIdx < length && !done)
-  {
-    char sym = edgeList[readIdx];
-    switch(state)
-    {
-      case INITIAL:
-        if (sym == '[') state = OUTER_LIST;
-        break;
-      case OUTER_LIST:
-      {
-        if (sym == '[') state = INNER_LIST;
-        else if (sym == ']') done = true;
-        else if (sym != ' ' && sym != ',') throw std::runtime_error("Bad edge list.");
-        break;
-      }
-      case INNER_LIST:
-      {
-        if (std::isdigit(sym))
-        {
-          currentVal = currentVal * 10 + (sym - '0');
-          readNb = true;
-        }
-        else if ((sym == ',' || sym == ']') && readNb)
-        {
-          readNb = false;
-          if (nrEnds < 2) nodes[nrEnds++] = currentVal;
-          else throw std::runtime_error("Invalid edge list.");
-          currentVal = 0;
-        }
-        if (sym == ']')
-        {
-          if (nrEnds != 2) throw std::runtime_error("Invalid edge list. Wrong number of ends.");
-          graph.insert(std::make_pair(nodes[0], nodes[1]));
-          nrEnds = 0;
-          state = OUTER_LIST;
-          nodes[0] = 0;
-          nodes[1] = 0;
-        }
-        break;
-      }
-    }
-    readIdx++;
-  }
-  return graph;
+  return edgeListToGraph(parse_edge_list(edgeList, length));
 }
 
 
@@ -208,15 +217,92 @@ graph_t majorminer::generate_petersen()
 
 graph_t majorminer::generate_erdosrenyi(fuint32_t n, float probability)
 {
-  ProbabilisticDecision<float> rand{};
-  graph_t erdos{};
-  for (fuint32_t i = 0; i < n; ++i)
+  return generate_erdosrenyi_csr(n, probability, nextStreamSeed()).toGraph();
+}
+
+CSRGraph majorminer::generate_erdosrenyi_csr(fuint32_t n, double probability, uint64_t seed)
+{
+  if (n == 0) return CSRGraph{};
+  const fuint32_t rowsPerBlock = 64;
+  const fuint32_t nbBlocks = (n + rowsPerBlock - 1) / rowsPerBlock;
+  const double logSkip = probability < 1.0 ? std::log1p(-probability) : 0.0;
+
+  // edges (i, j) with i < j of each row block, sorted lexicographically
+  Vector<edge_list_t> blockEdges(nbBlocks);
+  Vector<std::atomic<uint32_t>> inDegree(n);
+  tbb::parallel_for( tbb::blocked_range<fuint32_t>(0, nbBlocks, 1),
+    [&](const tbb::blocked_range<fuint32_t>& range) {
+      for (auto block = range.begin(); block != range.end(); ++block)
+      {
+        if (probability <= 0.0) continue;
+        ProbabilisticDecision<double> uniform{deriveSeed(seed, block)};
+        edge_list_t& edges = blockEdges[block];
+        uint64_t rowEnd = std::min<uint64_t>(n, (block + 1) * (uint64_t)rowsPerBlock);
+        uint64_t row = block * (uint64_t)rowsPerBlock;
+        uint64_t col = row; // last visited pair is (row, col)
+        while (row < rowEnd)
+        {
+          double skip = probability >= 1.0 ? 0.0 : std::floor(std::log1p(-uniform()) / logSkip);
+          if (skip >= (double)n * n) break;
+          col += 1 + (uint64_t)skip;
+          while (col >= n && row < rowEnd)
+          { // continue in the next row, whose first pair is (row + 1, row + 2)
+            col = col - n + row + 2;
+            row++;
+          }
+          if (row < rowEnd)
+          {
+            edges.push_back(std::make_pair(row, col));
+            inDegree[col].fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      }
+  });
+
+  size_t nbEdges = 0;
+  for (const auto& edges : blockEdges) nbEdges += edges.size();
+  if (2 * nbEdges > UINT32_MAX) throw std::runtime_error("Graph too large for CSR.");
+
+  // row v holds its smaller neighbors first, then its larger ones
+  Vector<uint32_t> outDegree(n, 0);
+  for (const auto& edges : blockEdges)
   {
-    for (fuint32_t j = i + 1; j < n; ++j)
-    {
-      if (rand(probability)) erdos.insert(std::make_pair(i,j));
-    }
+    for (const auto& edge : edges) outDegree[edge.first]++;
   }
-  return erdos;
+  Vector<uint32_t> offsets(n + 1, 0);
+  for (fuint32_t vertex = 0; vertex < n; ++vertex)
+  {
+    offsets[vertex + 1] = offsets[vertex] + inDegree[vertex].load() + outDegree[vertex];
+    inDegree[vertex].store(offsets[vertex]);
+  }
+
+  Vector<uint32_t> adjacency(offsets[n]);
+  tbb::parallel_for( tbb::blocked_range<fuint32_t>(0, nbBlocks, 1),
+    [&](const tbb::blocked_range<fuint32_t>& range) {
+      for (auto block = range.begin(); block != range.end(); ++block)
+      {
+        for (const auto& edge : blockEdges[block])
+        {
+          adjacency[inDegree[edge.second].fetch_add(1, std::memory_order_relaxed)] = edge.first;
+        }
+      }
+  });
+  tbb::parallel_for( tbb::blocked_range<fuint32_t>(0, nbBlocks, 1),
+    [&](const tbb::blocked_range<fuint32_t>& range) {
+      for (auto block = range.begin(); block != range.end(); ++block)
+      { // all smaller neighbors are placed, sort them and append the larger ones
+        fuint32_t rowBegin = block * rowsPerBlock;
+        fuint32_t rowEnd = std::min<fuint32_t>(n, rowBegin + rowsPerBlock);
+        for (fuint32_t vertex = rowBegin; vertex < rowEnd; ++vertex)
+        {
+          std::sort(adjacency.begin() + offsets[vertex], adjacency.begin() + inDegree[vertex].load());
+        }
+        for (const auto& edge : blockEdges[block])
+        {
+          adjacency[inDegree[edge.first].fetch_add(1, std::memory_order_relaxed)] = edge.second;
+        }
+      }
+  });
+  return CSRGraph{std::move(offsets), std::move(adjacency)};
 }
 
@@ -2,6 +2,7 @@
 #define __MAJORMINER_GRAPH_GEN_HPP_
 
 #include "majorminer_types.hpp"
+#include <common/csr_graph.hpp>
 
 
 namespace majorminer
@@ -13,8 +14,18 @@ namespace majorminer
   /// Generate a Chimera graph with rows x cols unit cells (each with 8 nodes).
   graph_t generate_chimera(fuint32_t rows, fuint32_t cols);
 
-  /// TODO: Implement generate Pegasus graph
-  graph_t generate_pegasus();
+  /// Generate the fabric of a Pegasus graph P(m) with the default shifts.
+  /// Nodes are numbered like the linear indices of dwave_networkx.
+  graph_t generate_pegasus(fuint32_t m);
+
+  /// Generate a Zephyr graph Z(m, t). Nodes are numbered like the linear
+  /// indices of dwave_networkx.
+  graph_t generate_zephyr(fuint32_t m, fuint32_t t);
+
+  /// Edges of Z(m, t) as pairs (u, v) with u < v, sorted lexicographically.
+  /// The edges of a node are contiguous, so the list can be turned into
+  /// CSR offsets directly.
+  edge_list_t generate_zephyr_edges(fuint32_t m, fuint32_t t);
 
   /// Generate a simple cyclic graph C_n
   graph_t generate_cyclegraph(fuint32_t n);
@@ -35,6 +46,11 @@ namespace majorminer
   // create an edge between the pair with "probability"
   graph_t generate_erdosrenyi(fuint32_t n, float probability);
 
+  // Same as above in O(n + m) by skipping geometrically distributed gaps
+  // between edges (Batagelj and Brandes). Rows are generated in blocks with
+  // streams derived from seed, so the graph only depends on the seed.
+  CSRGraph generate_erdosrenyi_csr(fuint32_t n, double probability, uint64_t seed);
+
 }
 
 
@@ -1,5 +1,7 @@
 #include <common/graph_info.hpp>
 
+#include <algorithm>
+
 using namespace majorminer;
 
 fuint32_t ChimeraGraphInfo::getXCoord(vertex_t vertex) const
@@ -12,4 +14,44 @@ fuint32_t ChimeraGraphInfo::getYCoord(vertex_t vertex) const
  return vertex / (m_width * 8);
 }
 
+namespace
+{
+  // Default shifts of the vertical and horizontal qubits in dwave_networkx
+  const fuint32_t PEGASUS_SHIFTS[2][12] = {
+    { 2, 2, 2, 2, 10, 10, 10, 10, 6, 6, 6, 6 },
+    { 6, 6, 6, 6, 2, 2, 2, 2, 10, 10, 10, 10 }
+  };
+}
+
+fuint32_t PegasusGraphInfo::getXCoord(vertex_t vertex) const
+{
+  return getU(vertex) == 0 ? getW(vertex) : getZ(vertex);
+}
+
+fuint32_t PegasusGraphInfo::getYCoord(vertex_t vertex) const
+{
+  return getU(vertex) == 0 ? getZ(vertex) : getW(vertex);
+}
 
+fuint32_t PegasusGraphInfo::getShift(fuint32_t u, fuint32_t k) const
+{
+  return PEGASUS_SHIFTS[u][k];
+}
+
+bool PegasusGraphInfo::isFabric(fuint32_t u, fuint32_t w, fuint32_t k) const
+{ // the crossing qubits are shifted by 2 to 10 along the line
+  const fuint32_t* shifts = PEGASUS_SHIFTS[1 - u];
+  fuint32_t minShift = *std::min_element(shifts, shifts + 12);
+  fuint32_t maxShift = *std::max_element(shifts, shifts + 12);
+  return !(w == 0 && k < minShift) && !(w + 1 == m_size && k >= maxShift);
+}
+
+fuint32_t ZephyrGraphInfo::getXCoord(vertex_t vertex) const
+{
+  return getU(vertex) == 0 ? getW(vertex) : 2 * getZ(vertex) + getJ(vertex);
+}
+
+fuint32_t ZephyrGraphInfo::getYCoord(vertex_t vertex) const
+{
+  return getU(vertex) == 0 ? 2 * getZ(vertex) + getJ(vertex) : getW(vertex);
+}
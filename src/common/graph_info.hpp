@@ -35,6 +35,124 @@ namespace majorminer
     fuint32_t m_width;
     fuint32_t m_height;
   };
+
+  // Pegasus P(m) with the linear indexing of dwave_networkx, i. e. a qubit
+  // (u, w, k, z) has index z + (m - 1) * (k + 12 * (w + m * u)). Vertical
+  // qubits (u = 0) lie in column 12w + k, horizontal ones in row 12w + k.
+  // The cell (x, y) of a qubit is (w, z) if vertical and (z, w) otherwise,
+  // so all neighbors of a qubit lie in adjacent cells.
+  struct PegasusGraphInfo
+  {
+    PegasusGraphInfo(): m_size(0) {}
+    PegasusGraphInfo(fuint32_t m): m_size(m) {}
+
+    fuint32_t getU(vertex_t vertex) const { return vertex / ((m_size - 1) * 12 * m_size); }
+    fuint32_t getW(vertex_t vertex) const { return (vertex / ((m_size - 1) * 12)) % m_size; }
+    fuint32_t getK(vertex_t vertex) const { return (vertex / (m_size - 1)) % 12; }
+    fuint32_t getZ(vertex_t vertex) const { return vertex % (m_size - 1); }
+    fuint32_t getXCoord(vertex_t vertex) const;
+    fuint32_t getYCoord(vertex_t vertex) const;
+    fuint32_t getWidth() const { return m_size; }
+    fuint32_t getHeight() const { return m_size; }
+    fuint32_t getNbVertices() const { return 24 * m_size * (m_size - 1); }
+
+    vertex_t getVertex(fuint32_t u, fuint32_t w, fuint32_t k, fuint32_t z) const
+    { return z + (m_size - 1) * (k + 12 * (w + m_size * u)); }
+
+    // Qubits without internal couplers are not part of the fabric
+    bool isFabric(fuint32_t u, fuint32_t w, fuint32_t k) const;
+    bool isFabric(vertex_t vertex) const { return isFabric(getU(vertex), getW(vertex), getK(vertex)); }
+    // Offset of a qubit along its line, in units of the crossing lines
+    fuint32_t getShift(fuint32_t u, fuint32_t k) const;
+
+    // Calls func for every fabric neighbor of a fabric qubit. Qubit (u, w, k, z)
+    // is coupled to (u, w, k, z +- 1), to (u, w, k ^ 1, z) and to all
+    // orthogonal qubits it crosses.
+    template<typename Functor>
+    void iterateNeighbors(vertex_t vertex, Functor func) const
+    {
+      fuint32_t u = getU(vertex), w = getW(vertex), k = getK(vertex), z = getZ(vertex);
+      if (z > 0) func(getVertex(u, w, k, z - 1));
+      if (z + 2 < m_size) func(getVertex(u, w, k, z + 1));
+      func(getVertex(u, w, k ^ 1, z));
+      for (fuint32_t kk = 0; kk < 12; ++kk)
+      {
+        fuint32_t crossW, crossZ;
+        if (u == 0)
+        {
+          crossW = z + (kk < getShift(0, k) ? 1 : 0);
+          crossZ = w - (k < getShift(1, kk) ? 1 : 0);
+        }
+        else
+        {
+          crossW = z + (kk < getShift(1, k) ? 1 : 0);
+          crossZ = w - (k < getShift(0, kk) ? 1 : 0);
+        }
+        // crossZ wraps around for the first line
+        if (crossW >= m_size || crossZ >= m_size - 1) continue;
+        if (!isFabric(1 - u, crossW, kk)) continue;
+        func(getVertex(1 - u, crossW, kk, crossZ));
+      }
+    }
+
+    fuint32_t m_size;
+  };
+
+  // Zephyr Z(m, t) with the linear indexing of dwave_networkx, i. e. a qubit
+  // (u, w, k, j, z) has index z + m * (j + 2 * (k + t * (w + (2m + 1) * u))).
+  // A vertical qubit lies in column w and spans the rows 2z + j and
+  // 2z + j + 1. The cell (x, y) of a qubit is (w, 2z + j) if vertical and
+  // (2z + j, w) otherwise. Neighbors lie at most two cells apart.
+  struct ZephyrGraphInfo
+  {
+    ZephyrGraphInfo(): m_size(0), m_tile(0) {}
+    ZephyrGraphInfo(fuint32_t m, fuint32_t t): m_size(m), m_tile(t) {}
+
+    fuint32_t getU(vertex_t vertex) const { return vertex / (m_size * 2 * m_tile * getWidth()); }
+    fuint32_t getW(vertex_t vertex) const { return (vertex / (m_size * 2 * m_tile)) % getWidth(); }
+    fuint32_t getK(vertex_t vertex) const { return (vertex / (m_size * 2)) % m_tile; }
+    fuint32_t getJ(vertex_t vertex) const { return (vertex / m_size) % 2; }
+    fuint32_t getZ(vertex_t vertex) const { return vertex % m_size; }
+    fuint32_t getXCoord(vertex_t vertex) const;
+    fuint32_t getYCoord(vertex_t vertex) const;
+    fuint32_t getWidth() const { return 2 * m_size + 1; }
+    fuint32_t getHeight() const { return 2 * m_size + 1; }
+    fuint32_t getNbVertices() const { return 4 * m_tile * m_size * getWidth(); }
+
+    vertex_t getVertex(fuint32_t u, fuint32_t w, fuint32_t k, fuint32_t j, fuint32_t z) const
+    { return z + m_size * (j + 2 * (k + m_tile * (w + getWidth() * u))); }
+
+    // Calls func for every neighbor. Qubit (u, w, k, j, z) is coupled to
+    // (u, w, k, j, z +- 1), to the parallel qubits with the other j it
+    // overlaps with and to the 4t orthogonal qubits it crosses.
+    template<typename Functor>
+    void iterateNeighbors(vertex_t vertex, Functor func) const
+    {
+      fuint32_t u = getU(vertex), w = getW(vertex), k = getK(vertex), j = getJ(vertex), z = getZ(vertex);
+      if (z > 0) func(getVertex(u, w, k, j, z - 1));
+      if (z + 1 < m_size) func(getVertex(u, w, k, j, z + 1));
+      func(getVertex(u, w, k, 1 - j, z));
+      if (j == 0 && z > 0) func(getVertex(u, w, k, 1, z - 1));
+      if (j == 1 && z + 1 < m_size) func(getVertex(u, w, k, 0, z + 1));
+      for (fuint32_t crossJ = 0; crossJ < 2; ++crossJ)
+      { // the crossing qubit spans the lines start and start + 1
+        if (w == 0 && crossJ == 1) continue;
+        fuint32_t start = (w % 2 == crossJ) ? w : (w - 1);
+        fuint32_t crossZ = (start - crossJ) / 2;
+        if (crossZ >= m_size) continue;
+        for (fuint32_t line = 2 * z + j; line < 2 * z + j + 2; ++line)
+        {
+          for (fuint32_t crossK = 0; crossK < m_tile; ++crossK)
+          {
+            func(getVertex(1 - u, line, crossK, crossJ, crossZ));
+          }
+        }
+      }
+    }
+
+    fuint32_t m_size;
+    fuint32_t m_tile;
+  };
 }
 
 
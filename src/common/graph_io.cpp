@@ -0,0 +1,235 @@
+#include <common/graph_io.hpp>
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef _WIN32
+#include <memory>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace majorminer;
+
+namespace
+{
+  const char BINARY_MAGIC[8] = { 'M', 'M', 'C', 'S', 'R', 0, 0, 0 };
+  const uint32_t BINARY_VERSION = 1;
+  const size_t MIN_CHUNK_SIZE = 1 << 16;
+
+  struct BinaryGraphHeader
+  {
+    char m_magic[8];
+    uint32_t m_version;
+    uint32_t m_nbVertices;
+    uint64_t m_nbArcs; // twice the number of edges
+  };
+
+  // Read-only view of a whole file. Falls back to reading the file into
+  // memory where mmap is not available.
+  class MappedFile
+  {
+    public:
+      MappedFile(const std::string& filename)
+        : m_data(nullptr), m_size(0)
+      {
+#ifdef _WIN32
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) throw std::runtime_error("File not found.");
+        m_size = file.tellg();
+        m_buffer = std::make_unique<char[]>(m_size);
+        file.seekg(0, std::ios::beg);
+        file.read(m_buffer.get(), m_size);
+        m_data = m_buffer.get();
+#else
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("File not found.");
+        struct stat info;
+        if (fstat(fd, &info) != 0)
+        {
+          close(fd);
+          throw std::runtime_error("Could not read file.");
+        }
+        m_size = info.st_size;
+        if (m_size > 0)
+        {
+          void* mapped = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+          if (mapped == MAP_FAILED)
+          {
+            close(fd);
+            throw std::runtime_error("Could not map file.");
+          }
+          m_data = static_cast<const char*>(mapped);
+        }
+        close(fd);
+#endif
+      }
+
+      ~MappedFile()
+      {
+#ifndef _WIN32
+        if (m_data != nullptr) munmap(const_cast<char*>(m_data), m_size);
+#endif
+      }
+
+      MappedFile(const MappedFile&) = delete;
+      MappedFile& operator=(const MappedFile&) = delete;
+
+      const char* data() const { return m_data; }
+      size_t size() const { return m_size; }
+
+    private:
+      const char* m_data;
+      size_t m_size;
+#ifdef _WIN32
+      std::unique_ptr<char[]> m_buffer;
+#endif
+  };
+
+  bool isSeparator(char sym) { return sym == ',' || std::isspace(static_cast<unsigned char>(sym)); }
+
+  // Parses the inner lists starting in [begin, end). The last list may
+  // extend beyond end. A chunk starting within a list skips its rest.
+  void parseChunk(const char* edgeList, size_t begin, size_t end,
+    size_t length, bool firstChunk, edge_list_t& edges)
+  {
+    size_t pos = begin;
+    if (!firstChunk)
+    {
+      size_t next = pos;
+      while (next < length && edgeList[next] != '[' && edgeList[next] != ']') next++;
+      if (next < length && edgeList[next] == ']') pos = next + 1;
+    }
+
+    while (pos < end)
+    {
+      char sym = edgeList[pos];
+      if (isSeparator(sym)) { pos++; continue; }
+      if (sym != '[') throw std::runtime_error("Bad edge list.");
+
+      fuint32_t nodes[] = { 0, 0 };
+      fuint32_t nrEnds = 0;
+      fuint32_t currentVal = 0;
+      bool readNb = false;
+      for (pos++; pos < length; ++pos)
+      {
+        sym = edgeList[pos];
+        if (std::isdigit(static_cast<unsigned char>(sym)))
+        {
+          currentVal = currentVal * 10 + (sym - '0');
+          readNb = true;
+        }
+        else if ((sym == ',' || sym == ']') && readNb)
+        {
+          if (nrEnds >= 2) throw std::runtime_error("Invalid edge list.");
+          nodes[nrEnds++] = currentVal;
+          currentVal = 0;
+          readNb = false;
+        }
+        else if (!std::isspace(static_cast<unsigned char>(sym)) && sym != ']')
+        {
+          throw std::runtime_error("Invalid edge list.");
+        }
+        if (sym == ']') break;
+      }
+      if (pos == length || nrEnds != 2) throw std::runtime_error("Invalid edge list. Wrong number of ends.");
+      edges.push_back(std::make_pair(nodes[0], nodes[1]));
+      pos++;
+    }
+  }
+}
+
+
+edge_list_t majorminer::parse_edge_list(const char* edgeList, size_t length)
+{
+  edge_list_t edges{};
+  const char* first = static_cast<const char*>(std::memchr(edgeList, '[', length));
+  if (first == nullptr) return edges;
+  size_t begin = (first - edgeList) + 1;
+  size_t end = length;
+  while (end > begin && edgeList[end - 1] != ']') end--;
+  if (end <= begin) throw std::runtime_error("Bad edge list.");
+  end--; // closing bracket of the outer list
+
+  size_t bodyLength = end - begin;
+  size_t nbChunks = std::max<size_t>(1, std::min<size_t>(bodyLength / MIN_CHUNK_SIZE,
+    4 * std::max(1U, std::thread::hardware_concurrency())));
+  Vector<edge_list_t> chunkEdges(nbChunks);
+  tbb::parallel_for( tbb::blocked_range<size_t>(0, nbChunks, 1),
+    [&](const tbb::blocked_range<size_t>& range) {
+      for (auto chunk = range.begin(); chunk != range.end(); ++chunk)
+      {
+        size_t chunkBegin = begin + (bodyLength * chunk) / nbChunks;
+        size_t chunkEnd = begin + (bodyLength * (chunk + 1)) / nbChunks;
+        parseChunk(edgeList, chunkBegin, chunkEnd, end, chunk == 0, chunkEdges[chunk]);
+      }
+  });
+
+  size_t total = 0;
+  for (const auto& chunk : chunkEdges) total += chunk.size();
+  edges.reserve(total);
+  for (const auto& chunk : chunkEdges) edges.insert(edges.end(), chunk.begin(), chunk.end());
+  return edges;
+}
+
+edge_list_t majorminer::import_edge_list(const std::string& filename)
+{
+  MappedFile file{filename};
+  return parse_edge_list(file.data(), file.size());
+}
+
+void majorminer::export_binary_graph(const std::string& filename, const CSRGraph& graph)
+{
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) throw std::runtime_error("Could not open file.");
+
+  BinaryGraphHeader header{};
+  std::memcpy(header.m_magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+  header.m_version = BINARY_VERSION;
+  header.m_nbVertices = graph.getNbVertices();
+  header.m_nbArcs = graph.getNbVertices() == 0 ? 0 : graph.getOffsets()[graph.getNbVertices()];
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (graph.getNbVertices() > 0)
+  {
+    file.write(reinterpret_cast<const char*>(graph.getOffsets()), (header.m_nbVertices + 1) * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(graph.getAdjacency()), header.m_nbArcs * sizeof(uint32_t));
+  }
+  if (!file) throw std::runtime_error("Could not write file.");
+}
+
+CSRGraph majorminer::import_binary_graph(const std::string& filename)
+{
+  auto file = std::make_shared<MappedFile>(filename);
+  BinaryGraphHeader header{};
+  if (file->size() < sizeof(header)) throw std::runtime_error("Bad binary graph.");
+  std::memcpy(&header, file->data(), sizeof(header));
+  if (std::memcmp(header.m_magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0
+    || header.m_version != BINARY_VERSION) throw std::runtime_error("Bad binary graph.");
+  if (header.m_nbVertices == 0) return CSRGraph{};
+  if (header.m_nbArcs > UINT32_MAX) throw std::runtime_error("Bad binary graph.");
+
+  // both counts fit into 32 bits, so the sum cannot overflow 64 bits
+  uint64_t nbWords = (uint64_t)header.m_nbVertices + 1 + header.m_nbArcs;
+  if (nbWords > (UINT64_MAX - sizeof(header)) / sizeof(uint32_t)
+    || file->size() != sizeof(header) + nbWords * sizeof(uint32_t)) throw std::runtime_error("Bad binary graph.");
+  const uint32_t* offsets = reinterpret_cast<const uint32_t*>(file->data() + sizeof(header));
+  const uint32_t* adjacency = offsets + header.m_nbVertices + 1;
+
+  // the graph is used without copying, so reject anything that reads out of bounds later
+  if (offsets[0] != 0 || offsets[header.m_nbVertices] != header.m_nbArcs) throw std::runtime_error("Bad binary graph.");
+  for (uint32_t vertex = 0; vertex < header.m_nbVertices; ++vertex)
+  {
+    if (offsets[vertex] > offsets[vertex + 1]) throw std::runtime_error("Bad binary graph.");
+  }
+  for (uint64_t arc = 0; arc < header.m_nbArcs; ++arc)
+  {
+    if (adjacency[arc] >= header.m_nbVertices) throw std::runtime_error("Bad binary graph.");
+  }
+  return CSRGraph{file, header.m_nbVertices, offsets, adjacency};
+}
@@ -0,0 +1,27 @@
+#ifndef __MAJORMINER_GRAPH_IO_HPP_
+#define __MAJORMINER_GRAPH_IO_HPP_
+
+#include <majorminer_types.hpp>
+#include <common/csr_graph.hpp>
+
+namespace majorminer
+{
+  /// Parse an edge list of the form [[u,v], [u,v], ...]. The input is split
+  /// into chunks which are parsed in parallel.
+  edge_list_t parse_edge_list(const char* edgeList, size_t length);
+
+  /// Memory map a file containing an edge list and parse it in parallel.
+  edge_list_t import_edge_list(const std::string& filename);
+
+  /// Write the graph in the binary format: a header followed by the CSR
+  /// offsets and adjacency arrays as 32 bit integers.
+  void export_binary_graph(const std::string& filename, const CSRGraph& graph);
+
+  /// Memory map a graph in the binary format. The returned graph views the
+  /// mapped arrays without copying them.
+  CSRGraph import_binary_graph(const std::string& filename);
+
+}
+
+
+#endif
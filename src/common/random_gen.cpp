@@ -1,30 +1,51 @@
 #include "common/random_gen.hpp"
 
 using namespace majorminer;
-RandomGen::RandomGen()
-  : m_generator(m_rdGen()),
-    m_shuffleGenerator(m_rdShuffle())
-{}
 
-fuint32_t RandomGen::getRandomUint(fuint32_t upper)
+namespace
 {
-  std::uniform_int_distribution<fuint32_t> distribution(0, upper);
-  while(!m_lock.try_lock()) {}
+  uint64_t initialMasterSeed()
+  {
+    std::random_device rd{};
+    return ((uint64_t)rd() << 32) ^ rd();
+  }
 
-  fuint32_t randomVal = distribution(m_generator);
+  std::atomic<uint64_t> masterSeed{initialMasterSeed()};
+  std::atomic<uint64_t> streamCounter{0};
+}
 
-  m_lock.unlock();
-  return randomVal;
+void majorminer::setMasterSeed(uint64_t seed)
+{
+  masterSeed = seed;
+  streamCounter = 0;
 }
 
+uint64_t majorminer::getMasterSeed()
+{
+  return masterSeed;
+}
 
-vertex_t RandomGen::getRandomVertex(const nodeset_t& vertices)
+uint64_t majorminer::deriveSeed(uint64_t seed, uint64_t stream)
 {
-  if (vertices.empty()) return FUINT32_UNDEF;
-  fuint32_t idx = getRandomUint(vertices.size() - 1);
-  for (auto vertex : vertices)
-  {
-    if (idx-- == 0) return vertex;
-  }
-  return FUINT32_UNDEF;
-}
\ No newline at end of file
+  uint64_t state = seed ^ splitmix64(stream);
+  return splitmix64(state);
+}
+
+uint64_t majorminer::nextStreamSeed()
+{
+  return deriveSeed(masterSeed, streamCounter++);
+}
+
+RandomGen::RandomGen()
+  : m_generator(nextStreamSeed())
+{}
+
+RandomGen::RandomGen(uint64_t seed)
+  : m_generator(seed)
+{}
+
+fuint32_t RandomGen::getRandomUint(fuint32_t upper)
+{
+  std::uniform_int_distribution<fuint32_t> distribution(0, upper);
+  return distribution(m_generator);
+}
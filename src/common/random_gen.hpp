@@ -6,48 +6,112 @@
 namespace majorminer
 {
 
+  inline uint64_t splitmix64(uint64_t& state)
+  {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  // xoshiro256** by Blackman and Vigna. Seeded through splitmix64.
+  class Xoshiro256
+  {
+    public:
+      typedef uint64_t result_type;
+
+      explicit Xoshiro256(uint64_t seed = 0) { this->seed(seed); }
+
+      void seed(uint64_t seed)
+      {
+        for (auto& s : m_state) s = splitmix64(seed);
+      }
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return (result_type)-1; }
+
+      result_type operator()()
+      {
+        const uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+        const uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
+      }
+
+    private:
+      static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    private:
+      uint64_t m_state[4];
+  };
+
+  // All generators are derived from a single master seed. Every generator
+  // created without an explicit seed gets the next stream of the master seed.
+  void setMasterSeed(uint64_t seed);
+  uint64_t getMasterSeed();
+  uint64_t nextStreamSeed();
+  uint64_t deriveSeed(uint64_t seed, uint64_t stream);
+
+  // Independent random streams of the embedding pipeline, see EmbeddingState::getTaskSeed
+  enum RandomStream : uint64_t
+  {
+    PLACEMENT_REDUCER = 1,
+    CSC_REDUCER,
+    FINAL_MUTATION_ORDER,
+    REDUCE_OVERLAP,
+    FRONTIER_CANDIDATES,
+    LMRP_CRATERS
+  };
+
+  // Not synchronized. Use one generator per thread or per task.
   class RandomGen
   {
     public:
       RandomGen();
+      explicit RandomGen(uint64_t seed);
+
+      void seed(uint64_t seed) { m_generator.seed(seed); }
+
       fuint32_t getRandomUint(fuint32_t upper);
 
       template<typename T>
       void shuffle(T* data, fuint32_t size)
       {
         if (size == 0) return;
-        while(!m_shuffleLock.try_lock()) {}
-
-        std::shuffle(data, data + size, m_shuffleGenerator);
+        std::shuffle(data, data + size, m_generator);
+      }
 
-        m_shuffleLock.unlock();
+      template<typename T>
+      const T& getRandomElement(const Vector<T>& elements)
+      {
+        return elements[getRandomUint(elements.size() - 1)];
       }
 
-      vertex_t getRandomVertex(const nodeset_t& vertices);
+      Xoshiro256& getGenerator() { return m_generator; }
 
     private:
-      std::mutex m_lock;
-      std::mutex m_shuffleLock;
-      std::random_device m_rdGen;
-      std::random_device m_rdShuffle;
-      std::default_random_engine m_generator;
-      std::default_random_engine m_shuffleGenerator;
+      Xoshiro256 m_generator;
   };
 
   template<typename T, typename = std::enable_if_t<std::is_floating_point<T>::value>>
   struct ProbabilisticDecision
   {
     public:
-      ProbabilisticDecision() : m_gen(m_rd()), m_dist(static_cast<T>(0.0), static_cast<T>(1.0)) {}
+      ProbabilisticDecision() : m_gen(nextStreamSeed()), m_dist(static_cast<T>(0.0), static_cast<T>(1.0)) {}
+      explicit ProbabilisticDecision(uint64_t seed) : m_gen(seed), m_dist(static_cast<T>(0.0), static_cast<T>(1.0)) {}
       T operator()() { return m_dist(m_gen); }
       bool operator()(T value) { return m_dist(m_gen) < value; }
 
     private:
-      std::random_device m_rd;
-      std::mt19937 m_gen;
+      Xoshiro256 m_gen;
       std::uniform_real_distribution<T> m_dist;
   };
 }
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,61 @@
+#include <common/target_topology.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <common/utils.hpp>
+
+using namespace majorminer;
+
+
+TargetTopology::TargetTopology(const graph_t& graph)
+  : m_graph(graph), m_csr(CSRGraph::fromGraph(m_graph))
+{
+  convertToAdjacencyList(m_adjacency, m_graph);
+  for (vertex_t vertex = 0; vertex < m_csr.getNbVertices(); ++vertex)
+  {
+    if (m_csr.getDegree(vertex) > 0) m_vertices.push_back(vertex);
+  }
+}
+
+DefectMask::DefectMask(const TargetTopology& topology)
+  : m_csr(topology.getCSR()),
+    m_inactiveVertices(topology.getCSR().getNbVertices(), 0),
+    m_inactiveArcs(2 * topology.getCSR().getNbEdges(), 0),
+    m_nbInactiveVertices(0), m_nbInactiveEdges(0) {}
+
+void DefectMask::deactivateVertex(vertex_t vertex)
+{
+  if (vertex >= m_inactiveVertices.size()) throw std::runtime_error("Vertex not in topology.");
+  if (m_inactiveVertices[vertex]) return;
+  m_inactiveVertices[vertex] = 1;
+  m_nbInactiveVertices++;
+}
+
+void DefectMask::deactivateEdge(vertex_t u, vertex_t v)
+{
+  if (!m_csr.hasEdge(u, v)) throw std::runtime_error("Edge not in topology.");
+  fuint32_t arc = findArc(u, v);
+  if (m_inactiveArcs[arc]) return;
+  m_inactiveArcs[arc] = 1;
+  m_inactiveArcs[findArc(v, u)] = 1;
+  m_nbInactiveEdges++;
+}
+
+void DefectMask::clear()
+{
+  std::fill(m_inactiveVertices.begin(), m_inactiveVertices.end(), 0);
+  std::fill(m_inactiveArcs.begin(), m_inactiveArcs.end(), 0);
+  m_nbInactiveVertices = 0;
+  m_nbInactiveEdges = 0;
+}
+
+fuint32_t DefectMask::findArc(vertex_t u, vertex_t v) const
+{
+  if (u >= m_csr.getNbVertices()) return FUINT32_UNDEF;
+  const uint32_t* begin = m_csr.getAdjacency() + m_csr.getOffsets()[u];
+  const uint32_t* end = m_csr.getAdjacency() + m_csr.getOffsets()[u + 1];
+  const uint32_t* found = std::lower_bound(begin, end, v);
+  if (found == end || *found != v) return FUINT32_UNDEF;
+  return found - m_csr.getAdjacency();
+}
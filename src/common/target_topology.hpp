@@ -0,0 +1,71 @@
+#ifndef __MAJORMINER_TARGET_TOPOLOGY_HPP_
+#define __MAJORMINER_TARGET_TOPOLOGY_HPP_
+
+#include <majorminer_types.hpp>
+#include <common/csr_graph.hpp>
+
+namespace majorminer
+{
+
+  // Preprocessed full topology of a target device. It is built once and
+  // shared by all embeddings, defects are applied through a DefectMask.
+  // The topology keeps its own copy of the graph. Masks and embeddings
+  // refer to the topology, so it has to outlive them.
+  class TargetTopology
+  {
+    public:
+      TargetTopology(const graph_t& graph);
+
+      const graph_t& getGraph() const { return m_graph; }
+      const adjacency_list_t& getAdjacency() const { return m_adjacency; }
+      const CSRGraph& getCSR() const { return m_csr; }
+      const Vector<vertex_t>& getVertices() const { return m_vertices; }
+
+    private:
+      graph_t m_graph;
+      adjacency_list_t m_adjacency;
+      CSRGraph m_csr;
+      Vector<vertex_t> m_vertices;
+  };
+
+  // Inactive qubits and couplers of a single calibration. Edges are marked
+  // per CSR arc of the topology, an edge is active if both its ends are.
+  class DefectMask
+  {
+    public:
+      DefectMask(const TargetTopology& topology);
+      DefectMask(TargetTopology&&) = delete;
+
+      void deactivateVertex(vertex_t vertex);
+      void deactivateEdge(vertex_t u, vertex_t v);
+      void clear();
+
+      bool isVertexActive(vertex_t vertex) const
+      { return vertex < m_inactiveVertices.size() && !m_inactiveVertices[vertex]; }
+
+      // Pairs which are not an edge of the topology are never active
+      bool isEdgeActive(vertex_t u, vertex_t v) const
+      {
+        if (!isVertexActive(u) || !isVertexActive(v)) return false;
+        fuint32_t arc = findArc(u, v);
+        return arc != FUINT32_UNDEF && (m_nbInactiveEdges == 0 || !m_inactiveArcs[arc]);
+      }
+
+      fuint32_t getNbInactiveVertices() const { return m_nbInactiveVertices; }
+      fuint32_t getNbInactiveEdges() const { return m_nbInactiveEdges; }
+
+    private:
+      fuint32_t findArc(vertex_t u, vertex_t v) const;
+
+    private:
+      const CSRGraph& m_csr;
+      Vector<char> m_inactiveVertices;
+      Vector<char> m_inactiveArcs;
+      fuint32_t m_nbInactiveVertices;
+      fuint32_t m_nbInactiveEdges;
+  };
+
+}
+
+
+#endif
@@ -1,9 +1,145 @@
 #include "common/time_measurement.hpp"
 
-namespace majorminer
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+using namespace majorminer;
+
+namespace
+{
+  struct MergedNode
+  {
+    std::string m_label;
+    Vector<fuint32_t> m_children;
+    double m_totalMs = 0;
+    uint64_t m_count = 0;
+  };
+
+  template<typename Tree>
+  void merge(Vector<MergedNode>& merged, fuint32_t mergedIdx, const Tree& nodes, fuint32_t nodeIdx)
+  {
+    for (fuint32_t child : nodes[nodeIdx].m_children)
+    {
+      const auto& node = nodes[child];
+      fuint32_t target = FUINT32_UNDEF;
+      for (fuint32_t candidate : merged[mergedIdx].m_children)
+      {
+        if (merged[candidate].m_label == node.m_label) { target = candidate; break; }
+      }
+      if (target == FUINT32_UNDEF)
+      {
+        target = merged.size();
+        merged.push_back(MergedNode{ node.m_label, {} });
+        merged[mergedIdx].m_children.push_back(target);
+      }
+      merged[target].m_totalMs += node.m_totalMs;
+      merged[target].m_count += node.m_count;
+      merge(merged, target, nodes, child);
+    }
+  }
+
+  void flatten(Vector<MergedNode>& merged, fuint32_t idx, const std::string& path,
+    fuint32_t depth, Vector<ProfileEntry>& entries)
+  {
+    auto& children = merged[idx].m_children;
+    std::sort(children.begin(), children.end(), [&](fuint32_t a, fuint32_t b){
+      return merged[a].m_totalMs > merged[b].m_totalMs;
+    });
+    for (fuint32_t child : children)
+    {
+      const auto& node = merged[child];
+      std::string childPath = path.empty() ? node.m_label : path + "/" + node.m_label;
+      entries.push_back(ProfileEntry{ childPath, depth, node.m_totalMs, node.m_count });
+      flatten(merged, child, childPath, depth + 1, entries);
+    }
+  }
+}
+
+fuint32_t Profiler::ThreadTree::getChild(fuint32_t parent, const char* label)
+{
+  for (fuint32_t child : m_nodes[parent].m_children)
+  {
+    const char* childLabel = m_nodes[child].m_label;
+    if (childLabel == label || std::strcmp(childLabel, label) == 0) return child;
+  }
+  fuint32_t child = m_nodes.size();
+  m_nodes.push_back(Node{ label, parent, {} });
+  m_nodes[parent].m_children.push_back(child);
+  return child;
+}
+
+ProfileContext Profiler::getContext()
+{
+  ProfileContext context{};
+  if (!m_enabled) return context;
+  const auto& tree = m_trees.local();
+  for (fuint32_t current = tree.m_current; current != 0; current = tree.m_nodes[current].m_parent)
+  {
+    context.push_back(tree.m_nodes[current].m_label);
+  }
+  std::reverse(context.begin(), context.end());
+  return context;
+}
+
+ProfileReport Profiler::report() const
 {
+  Vector<MergedNode> merged(1);
+  for (const auto& tree : m_trees) merge(merged, 0, tree.m_nodes, 0);
+  ProfileReport report{};
+  flatten(merged, 0, "", 0, report.m_entries);
+  return report;
+}
 
-double TIME_MUTATION = 0, TIME_REDUCE = 0;
-double GENERATE_POP = 0, OPTIMIZE = 0;
+const ProfileEntry* ProfileReport::find(const std::string& path) const
+{
+  for (const auto& entry : m_entries)
+  {
+    if (entry.m_path == path) return &entry;
+  }
+  return nullptr;
+}
 
+void ProfileReport::print(std::ostream& os) const
+{
+  for (const auto& entry : m_entries)
+  {
+    std::string label = entry.m_path.substr(entry.m_path.rfind('/') + 1);
+    os << std::string(2 * entry.m_depth, ' ') << std::left << std::setw(40 - 2 * entry.m_depth) << label
+       << std::right << std::fixed << std::setprecision(3) << std::setw(12) << entry.m_totalMs << " ms"
+       << std::setw(10) << entry.m_count << " calls" << std::endl;
+  }
+}
+
+ProfileScope::ProfileScope(Profiler& profiler, const char* label)
+  : m_tree(nullptr)
+{
+  if (!profiler.m_enabled) return;
+  m_tree = &profiler.m_trees.local();
+  m_previous = m_tree->m_current;
+  m_node = m_tree->getChild(m_previous, label);
+  m_tree->m_current = m_node;
+  m_start = std::chrono::steady_clock::now();
+}
+
+ProfileScope::ProfileScope(Profiler& profiler, const char* label, const ProfileContext& parent)
+  : m_tree(nullptr)
+{
+  if (!profiler.m_enabled) return;
+  m_tree = &profiler.m_trees.local();
+  m_previous = m_tree->m_current;
+  fuint32_t node = 0;
+  for (const char* parentLabel : parent) node = m_tree->getChild(node, parentLabel);
+  m_node = m_tree->getChild(node, label);
+  m_tree->m_current = m_node;
+  m_start = std::chrono::steady_clock::now();
+}
+
+ProfileScope::~ProfileScope()
+{
+  if (m_tree == nullptr) return;
+  auto& node = m_tree->m_nodes[m_node];
+  node.m_totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+  node.m_count++;
+  m_tree->m_current = m_previous;
 }
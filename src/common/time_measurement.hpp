@@ -1,22 +1,118 @@
 #ifndef __MAJORMINER_TIME_MEASUREMENT_HPP_
 #define __MAJORMINER_TIME_MEASUREMENT_HPP_
 
+#include <majorminer_types.hpp>
+
+#include <tbb/enumerable_thread_specific.h>
+
 #include <chrono>
+#include <ostream>
+#include <string>
 
-#define CHRONO_STUFF(t1, t2, diff, var, ...)  \
-  auto t1 = std::chrono::high_resolution_clock::now();    \
-   __VA_ARGS__                                            \
-  auto t2 = std::chrono::high_resolution_clock::now();    \
-  std::chrono::duration<double> diff = t2 - t1;           \
-  var+=diff.count();
+// Setting MAJORMINER_PROFILING to 0 removes all profiling scopes at compile time
+#ifndef MAJORMINER_PROFILING
+#define MAJORMINER_PROFILING 1
+#endif
 
+#define MM_PROFILE_CONCAT_(a, b) a##b
+#define MM_PROFILE_CONCAT(a, b) MM_PROFILE_CONCAT_(a, b)
 
-#define PRINT_TIME(name) std::cout << "Time: " << #name << ": " << name << std::endl;
+#if MAJORMINER_PROFILING == 1
+// Times the rest of the enclosing block. The optional context places the
+// scope below the scopes of another thread, see Profiler::getContext.
+#define PROFILE_SCOPE(profiler, label, ...) \
+  majorminer::ProfileScope MM_PROFILE_CONCAT(profileScope, __LINE__){profiler, label __VA_OPT__(,) __VA_ARGS__};
+#define PROFILE_CONTEXT(profiler, name) \
+  const majorminer::ProfileContext name = (profiler).getContext();
+#else
+#define PROFILE_SCOPE(profiler, label, ...)
+#define PROFILE_CONTEXT(profiler, name)
+#endif
 
 namespace majorminer
 {
-  extern double TIME_MUTATION, TIME_REDUCE;
-  extern double GENERATE_POP, OPTIMIZE;
+  // Labels of the open scopes of a thread, outermost first
+  typedef Vector<const char*> ProfileContext;
+
+  struct ProfileEntry
+  {
+    std::string m_path; // labels separated by '/'
+    fuint32_t m_depth;
+    double m_totalMs;
+    uint64_t m_count;
+  };
+
+  // Scopes of all threads merged by their path in depth-first order. The
+  // time of scopes running in parallel is summed over the threads.
+  struct ProfileReport
+  {
+    Vector<ProfileEntry> m_entries;
+
+    const ProfileEntry* find(const std::string& path) const;
+    void print(std::ostream& os) const;
+  };
+
+  // Hierarchical wall time profiler. Every thread aggregates its scopes into
+  // its own tree, so opening and closing a scope takes no lock. Disabled
+  // profilers skip the scopes without reading the clock. Labels have to
+  // outlive the profiler, e.g. string literals.
+  class Profiler
+  {
+    friend class ProfileScope;
+
+    public:
+      void setEnabled(bool enabled) { m_enabled = enabled; }
+      bool isEnabled() const { return m_enabled; }
+
+      // Path of the open scopes of the calling thread. Passed to the scopes of
+      // tasks running on other threads.
+      ProfileContext getContext();
+
+      // Must not be called while scopes are open
+      ProfileReport report() const;
+      void clear() { m_trees.clear(); }
+
+    private:
+      struct Node
+      {
+        const char* m_label;
+        fuint32_t m_parent;
+        Vector<fuint32_t> m_children;
+        double m_totalMs = 0;
+        uint64_t m_count = 0;
+      };
+
+      struct ThreadTree
+      {
+        ThreadTree() : m_nodes(1, Node{ "", 0, {} }), m_current(0) {}
+
+        fuint32_t getChild(fuint32_t parent, const char* label);
+
+        Vector<Node> m_nodes; // root at index 0
+        fuint32_t m_current;
+      };
+
+    private:
+      tbb::enumerable_thread_specific<ThreadTree> m_trees;
+      bool m_enabled = false;
+  };
+
+  class ProfileScope
+  {
+    public:
+      ProfileScope(Profiler& profiler, const char* label);
+      ProfileScope(Profiler& profiler, const char* label, const ProfileContext& parent);
+      ~ProfileScope();
+
+      ProfileScope(const ProfileScope&) = delete;
+      ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+      Profiler::ThreadTree* m_tree;
+      fuint32_t m_node;
+      fuint32_t m_previous;
+      std::chrono::steady_clock::time_point m_start;
+  };
 }
 
 
@@ -6,13 +6,15 @@ using namespace majorminer;
 
 
 
+// Sequential on purpose: the order of equal keys in the multimap depends on
+// the insertion order, and the embedding must not depend on thread timing.
 void majorminer::convertToAdjacencyList(adjacency_list_t& adj, const graph_t& graph)
 {
-  tbb::parallel_for_each(graph.begin(), graph.end(),
-    [&adj](const edge_t& edge){
-      adj.insert(std::make_pair(edge.first, edge.second));
-      adj.insert(std::make_pair(edge.second, edge.first));
-  });
+  for (const auto& edge : graph)
+  {
+    adj.insert(std::make_pair(edge.first, edge.second));
+    adj.insert(std::make_pair(edge.second, edge.first));
+  }
 }
 
 
@@ -80,6 +82,6 @@ fuint32_t majorminer::calculateFitness(const EmbeddingBase& state, const nodeset
 
 bool majorminer::containsEdge(const graph_t& graph, edge_t edge)
 {
-  return graph.contains(orderedPair(edge));
+  return graph.contains(edge) || graph.contains(reversePair(edge));
 }
 
@@ -14,7 +14,7 @@ namespace majorminer
   std::pair<T,T> orderedPair(const T& e1, const T& e2)
   {
     if (Comparator()(e1, e2)) return std::make_pair(e1, e2);
-    else return std::make_pair(e1, e2);
+    else return std::make_pair(e2, e1);
   }
 
   template<typename T, typename Comparator = std::less<T>>
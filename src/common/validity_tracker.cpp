@@ -0,0 +1,143 @@
+#include <common/validity_tracker.hpp>
+
+#include <algorithm>
+
+#include <common/embedding_base.hpp>
+
+using namespace majorminer;
+
+
+ValidityTracker::ValidityTracker(const EmbeddingBase& base)
+  : m_base(base), m_nbOverlapped(0), m_nbUncovered(0), m_nbUnmapped(0), m_nbDisconnected(0)
+{}
+
+void ValidityTracker::initialize()
+{
+  m_source = CSRGraph::fromGraph(*m_base.getSourceGraph());
+  fuint32_t nbSources = m_source.getNbVertices();
+  m_chainSizes.assign(nbSources, 0);
+  m_chainChanged.assign(nbSources, 0);
+  m_chainDisconnected.assign(nbSources, 0);
+  m_couplings.assign(2 * m_source.getNbEdges(), 0);
+  m_changedChains.clear();
+  m_targetLoad.clear();
+
+  m_nbOverlapped = 0;
+  m_nbUncovered = m_source.getNbEdges();
+  m_nbDisconnected = 0;
+  m_nbUnmapped = 0;
+  for (vertex_t vertex = 0; vertex < nbSources; ++vertex)
+  {
+    if (m_source.getDegree(vertex) > 0) m_nbUnmapped++;
+  }
+
+  const auto& mapping = m_base.getMapping();
+  for (const auto& mapped : mapping) insertPair(mapped.first, mapped.second);
+}
+
+void ValidityTracker::insertPair(vertex_t source, vertex_t target)
+{
+  if (source >= m_chainSizes.size()) return;
+  if (target >= m_targetLoad.size()) m_targetLoad.resize(target + 1, 0);
+  if (++m_targetLoad[target] == 2) m_nbOverlapped++;
+  if (++m_chainSizes[source] == 1 && m_source.getDegree(source) > 0) m_nbUnmapped--;
+  updateCouplings(source, target, 1);
+  markChanged(source);
+}
+
+void ValidityTracker::erasePair(vertex_t source, vertex_t target)
+{
+  if (source >= m_chainSizes.size() || target >= m_targetLoad.size()) return;
+  if (--m_targetLoad[target] == 1) m_nbOverlapped--;
+  if (--m_chainSizes[source] == 0 && m_source.getDegree(source) > 0) m_nbUnmapped++;
+  updateCouplings(source, target, -1);
+  markChanged(source);
+}
+
+// Couplings of (source, target) with all other pairs of the mapping
+void ValidityTracker::updateCouplings(vertex_t source, vertex_t target, int delta)
+{
+  m_base.iterateReverseMapping(target, [&](vertex_t other){
+    if (other != source) couple(source, other, delta);
+  });
+  m_base.iterateTargetAdjacentReverseMapping(target, [&](vertex_t other){
+    if (other != source) couple(source, other, delta);
+  });
+}
+
+void ValidityTracker::couple(vertex_t sourceA, vertex_t sourceB, int delta)
+{
+  if (sourceA > sourceB) std::swap(sourceA, sourceB);
+  if (sourceB >= m_source.getNbVertices()) return;
+  const uint32_t* begin = m_source.getAdjacency() + m_source.getOffsets()[sourceA];
+  const uint32_t* end = m_source.getAdjacency() + m_source.getOffsets()[sourceA + 1];
+  const uint32_t* found = std::lower_bound(begin, end, sourceB);
+  if (found == end || *found != sourceB) return;
+
+  fuint32_t& couplings = m_couplings[found - m_source.getAdjacency()];
+  fuint32_t before = couplings;
+  couplings += delta;
+  if (before == 0 && couplings > 0) m_nbUncovered--;
+  else if (before > 0 && couplings == 0) m_nbUncovered++;
+}
+
+void ValidityTracker::markChanged(vertex_t source)
+{
+  if (m_chainChanged[source]) return;
+  m_chainChanged[source] = 1;
+  m_changedChains.push_back(source);
+}
+
+fuint32_t ValidityTracker::getNbDisconnectedChains()
+{
+  for (vertex_t source : m_changedChains)
+  {
+    m_chainChanged[source] = 0;
+    bool disconnected = !isChainConnected(source);
+    if (disconnected != (bool)m_chainDisconnected[source])
+    {
+      if (disconnected) m_nbDisconnected++;
+      else m_nbDisconnected--;
+      m_chainDisconnected[source] = disconnected;
+    }
+  }
+  m_changedChains.clear();
+  return m_nbDisconnected;
+}
+
+double ValidityTracker::getProgress() const
+{
+  if (m_source.getNbEdges() == 0) return m_nbUnmapped == 0 ? 1.0 : 0.0;
+  return 1.0 - static_cast<double>(m_nbUncovered) / m_source.getNbEdges();
+}
+
+bool ValidityTracker::isValid()
+{
+  if (m_nbOverlapped != 0 || m_nbUncovered != 0 || m_nbUnmapped != 0) return false;
+  return getNbDisconnectedChains() == 0;
+}
+
+bool ValidityTracker::isChainConnected(vertex_t source) const
+{
+  if (m_chainSizes[source] <= 1) return true;
+  nodeset_t chain{};
+  m_base.iterateSourceMapping(source, [&](vertex_t target){ chain.insert(target); });
+
+  nodeset_t visited{};
+  Stack<vertex_t> dfsStack{};
+  dfsStack.push(*chain.begin());
+  visited.insert(*chain.begin());
+  while(!dfsStack.empty())
+  {
+    vertex_t current = dfsStack.top();
+    dfsStack.pop();
+    m_base.iterateTargetGraphAdjacent(current, [&](vertex_t adjacent){
+      if (chain.contains(adjacent) && !visited.contains(adjacent))
+      {
+        visited.insert(adjacent);
+        dfsStack.push(adjacent);
+      }
+    });
+  }
+  return visited.size() == chain.size();
+}
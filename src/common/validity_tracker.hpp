@@ -0,0 +1,64 @@
+#ifndef __MAJORMINER_VALIDITY_TRACKER_HPP_
+#define __MAJORMINER_VALIDITY_TRACKER_HPP_
+
+#include <majorminer_types.hpp>
+#include <common/csr_graph.hpp>
+
+namespace majorminer
+{
+
+  // Keeps the validity counters of an embedding up to date while pairs are
+  // inserted into and erased from the mapping. A source edge is covered by
+  // every pair of target vertices of the two chains that are equal or
+  // adjacent, the number of such couplings is stored per source edge.
+  // Chains are only checked for connectivity on request and only if they
+  // changed. Not synchronized, called while the mapping is being modified.
+  class ValidityTracker
+  {
+    public:
+      ValidityTracker(const EmbeddingBase& base);
+
+      void initialize();
+      // after the pair was inserted into the mapping and reverse mapping
+      void insertPair(vertex_t source, vertex_t target);
+      // before the pair is erased from the mapping and reverse mapping
+      void erasePair(vertex_t source, vertex_t target);
+
+      fuint32_t getNbOverlappedTargets() const { return m_nbOverlapped; }
+      fuint32_t getNbUncoveredEdges() const { return m_nbUncovered; }
+      fuint32_t getNbUnmappedVertices() const { return m_nbUnmapped; }
+      fuint32_t getNbSourceEdges() const { return m_source.getNbEdges(); }
+      fuint32_t getNbDisconnectedChains();
+
+      // Ratio of covered source edges
+      double getProgress() const;
+      bool isValid();
+
+    private:
+      void updateCouplings(vertex_t source, vertex_t target, int delta);
+      void couple(vertex_t sourceA, vertex_t sourceB, int delta);
+      void markChanged(vertex_t source);
+      bool isChainConnected(vertex_t source) const;
+
+    private:
+      const EmbeddingBase& m_base;
+      CSRGraph m_source;
+
+      Vector<fuint32_t> m_targetLoad;  // number of chains per target vertex
+      Vector<fuint32_t> m_chainSizes;
+      Vector<fuint32_t> m_couplings;   // per source arc from the smaller vertex
+
+      Vector<char> m_chainChanged;
+      Vector<char> m_chainDisconnected;
+      Vector<vertex_t> m_changedChains;
+
+      fuint32_t m_nbOverlapped;
+      fuint32_t m_nbUncovered;
+      fuint32_t m_nbUnmapped;
+      fuint32_t m_nbDisconnected;
+  };
+
+}
+
+
+#endif
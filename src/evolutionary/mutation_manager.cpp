@@ -16,6 +16,11 @@ void MutationManager::operator()(bool finalIteration)
 {
   if (!finalIteration) prepare();
   else prepareFinal();
+  if (m_state.isDeterministic())
+  {
+    runDeterministic();
+    return;
+  }
   m_done = false;
   m_runningPreps = 0;
   m_wait = false;
@@ -27,6 +32,8 @@ void MutationManager::operator()(bool finalIteration)
   auto& runningPreps = m_runningPreps;
   auto& remaining = m_numberRemaining;
   auto& free = m_free;
+  [[maybe_unused]] auto& profiler = m_state.getProfiler();
+  PROFILE_CONTEXT(profiler, context)
 
   auto prepareLambda = [&](){
     MutationPtr mutation;
@@ -39,6 +46,7 @@ void MutationManager::operator()(bool finalIteration)
         free.lock_shared();
         runningPreps++;
         free.unlock_shared();
+        PROFILE_SCOPE(profiler, "prepare", context)
         bool valid = mutation->prepare();
         if (valid) incorporationQueue.push(std::move(mutation));
         else remaining--;
@@ -50,7 +58,10 @@ void MutationManager::operator()(bool finalIteration)
   auto& threadManager = m_state.getThreadManager();
   fuint32_t threadCount = std::min(threadManager.getAvailableThreads() - 1, prepQueue.unsafe_size());
   threadManager.runMultiple(prepareLambda, threadCount);
-  incorporate();
+  {
+    PROFILE_SCOPE(profiler, "incorporate")
+    incorporate();
+  }
 
   threadManager.wait();
   m_embeddingManager.synchronize();
@@ -85,7 +96,7 @@ void MutationManager::prepareFinal()
   }
 
 
-  RandomGen rand{};
+  RandomGen rand{m_state.getTaskSeed(RandomStream::FINAL_MUTATION_ORDER, 0)};
   rand.shuffle(vertices.data(), vertices.size());
   for (auto vertex : vertices)
   {
@@ -94,6 +105,46 @@ void MutationManager::prepareFinal()
   m_numberRemaining = m_prepQueue.unsafe_size();
 }
 
+// Processes the mutations in rounds: all mutations of a round are prepared
+// in parallel and then validated and executed in queue order. Invalid
+// mutations are requeued into the next round after synchronizing.
+void MutationManager::runDeterministic()
+{
+  m_round.clear();
+  MutationPtr mutation;
+  while (m_prepQueue.try_pop(mutation)) m_round.push_back(std::move(mutation));
+
+  [[maybe_unused]] auto& profiler = m_state.getProfiler();
+  PROFILE_CONTEXT(profiler, context)
+  while (!m_round.empty())
+  {
+    m_prepared.assign(m_round.size(), 0);
+    tbb::parallel_for( tbb::blocked_range<size_t>(0, m_round.size(), 1),
+      [&](const tbb::blocked_range<size_t>& range) {
+        for (auto idx = range.begin(); idx != range.end(); ++idx)
+        {
+          PROFILE_SCOPE(profiler, "prepare", context)
+          m_prepared[idx] = m_round[idx]->prepare();
+        }
+    });
+
+    m_requeued.clear();
+    {
+      PROFILE_SCOPE(profiler, "incorporate")
+      for (size_t idx = 0; idx < m_round.size(); ++idx)
+      {
+        if (!m_prepared[idx]) continue;
+        auto& current = m_round[idx];
+        if (current->isValid()) current->execute();
+        else if (current->requeue()) m_requeued.push_back(std::move(current));
+      }
+    }
+    m_embeddingManager.synchronize();
+    std::swap(m_round, m_requeued);
+  }
+  m_numberRemaining = 0;
+}
+
 void MutationManager::clear()
 {
   m_embeddingManager.clear();
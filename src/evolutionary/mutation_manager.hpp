@@ -22,6 +22,7 @@ namespace majorminer
       void prepare();
       void prepareFinal();
       void incorporate();
+      void runDeterministic();
       void prepareMutations(fuint32_t node);
 
     private:
@@ -29,6 +30,9 @@ namespace majorminer
       EmbeddingManager& m_embeddingManager;
       Queue<MutationPtr> m_prepQueue;
       Queue<MutationPtr> m_incorporationQueue;
+      Vector<MutationPtr> m_round;
+      Vector<MutationPtr> m_requeued;
+      Vector<char> m_prepared;
       std::atomic<bool> m_done;
       std::atomic<fuint32_t> m_runningPreps;
       std::atomic<bool> m_wait;
@@ -14,6 +14,7 @@ MutationReduceOverlap::MutationReduceOverlap(EmbeddingState& state,
         : m_state(state), m_manager(manager), m_sourceVertex(sourceVertex)
 {
   m_reducer = new SuperVertexReducer{ m_state, sourceVertex };
+  m_reducer->setSeed(m_state.getTaskSeed(RandomStream::REDUCE_OVERLAP, sourceVertex));
 }
 
 MutationReduceOverlap::~MutationReduceOverlap()
@@ -6,36 +6,43 @@
 #include <common/embedding_visualizer.hpp>
 #include <common/time_measurement.hpp>
 
-#define POPULATION_SIZE 5
-#define ITERATION_LIMIT 10
-#define MAX_NEW_VERTICES 15
-#define REDUCE_ITERATION_COEFFICIENT 1
+#include <bit>
 
 using namespace majorminer;
 
 namespace
 {
-  template<typename T>
-  void swapPointers(T*& from, T*& to)
+  template<typename Functor>
+  void iterateBits(const Vector<uint64_t>& bits, Functor func)
   {
-    T*& temp = to;
-    to = from;
-    from = temp;
+    for (fuint32_t word = 0; word < bits.size(); ++word)
+    {
+      uint64_t remaining = bits[word];
+      while (remaining != 0)
+      {
+        func((fuint32_t)(word * 64 + std::countr_zero(remaining)));
+        remaining &= remaining - 1;
+      }
+    }
   }
 }
 
 EvolutionaryCSCReducer::EvolutionaryCSCReducer(EmbeddingState& state,
   vertex_t sourceVertex)
-  : m_state(state), m_sourceVertex(sourceVertex), m_wasPlaced(true),
-    m_improved(false), m_visualizer(nullptr), m_threadManager(state.getThreadManager())
+  : m_state(state), m_config(state.getConfig().m_evolutionary), m_sourceVertex(sourceVertex),
+    m_wasPlaced(true), m_improved(false), m_multithreaded(true), m_visualizer(nullptr),
+    m_threadManager(state.getThreadManager()), m_profiler(state.getProfiler()),
+    m_seed(state.getTaskSeed(RandomStream::CSC_REDUCER, sourceVertex)), m_evaluations(0), m_elapsedMs(0), m_stoppedByBudget(false)
 {
   initialize();
 }
 
 EvolutionaryCSCReducer::EvolutionaryCSCReducer(EmbeddingState& state,
   const nodeset_t& initial, vertex_t sourceVertex)
-    : m_state(state), m_sourceVertex(sourceVertex), m_wasPlaced(false),
-      m_improved(false), m_visualizer(nullptr), m_threadManager(state.getThreadManager())
+    : m_state(state), m_config(state.getConfig().m_evolutionary), m_sourceVertex(sourceVertex),
+      m_wasPlaced(false), m_improved(false), m_multithreaded(true), m_visualizer(nullptr),
+      m_threadManager(state.getThreadManager()), m_profiler(state.getProfiler()),
+      m_seed(state.getTaskSeed(RandomStream::CSC_REDUCER, sourceVertex)), m_evaluations(0), m_elapsedMs(0), m_stoppedByBudget(false)
 {
   initialize(initial);
 }
@@ -43,28 +50,40 @@ EvolutionaryCSCReducer::EvolutionaryCSCReducer(EmbeddingState& state,
 void EvolutionaryCSCReducer::optimize()
 {
   if (!m_expansionPossible) return;
+  m_start = std::chrono::steady_clock::now();
+  m_stoppedByBudget = false;
+  m_random.seed(m_seed);
+  {
+    PROFILE_SCOPE(m_profiler, "initialize population")
+    initializePopulations();
+  }
   // double initialFitness = m_bestFitness;
   Vector<CSCIndividual>* current = &m_populationA;
   Vector<CSCIndividual>* next = &m_populationB;
 
-  for (fuint32_t iteration = 0; iteration < ITERATION_LIMIT; ++iteration)
+  for (fuint32_t iteration = 0; iteration < m_config.m_iterationLimit; ++iteration)
   {
-    CHRONO_STUFF(t1,t2,diff1,OPTIMIZE, optimizeIteration(*current);)
+    {
+      PROFILE_SCOPE(m_profiler, "optimize iteration")
+      optimizeIteration(*current);
+    }
     if (m_visualizer != nullptr) visualize(iteration + 1, current);
 
-    if (iteration + 1 != ITERATION_LIMIT)
+    if (iteration + 1 != m_config.m_iterationLimit)
     {
-      CHRONO_STUFF(t3,t4,diff2,GENERATE_POP,
+      if (budgetExhausted())
+      {
+        m_stoppedByBudget = true;
+        break;
+      }
+      PROFILE_SCOPE(m_profiler, "next generation")
       bool success = createNextGeneration(*current, *next);
-      if (!success) break;)
-      swapPointers(current, next);
+      if (!success) break;
+      std::swap(current, next);
     }
   }
+  m_elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
   if (m_visualizer != nullptr) visualize(FUINT32_UNDEF, nullptr);
-  // PRINT_TIME(TIME_MUTATION)
-  // PRINT_TIME(TIME_REDUCE)
-  // PRINT_TIME(OPTIMIZE)
-  // PRINT_TIME(GENERATE_POP)
   // std::cout << initialFitness << " to " << m_bestFitness << " (" << m_bestSuperVertex.size() << ")" << std::endl;
 }
 
@@ -89,7 +108,8 @@ void EvolutionaryCSCReducer::visualize(fuint32_t iteration, Vector<CSCIndividual
     std::stringstream ss;
     for (fuint32_t idx = 0; idx < population->size(); ++idx)
     {
-      const auto& placement = population->at(idx).getSuperVertex();
+      nodeset_t placement{};
+      population->at(idx).getSuperVertex(placement);
       CREATE_IT_STRING(placement)
       embedding_mapping_t adjusted = replaceMapping(m_state.getMapping(), placement, m_sourceVertex);
       m_visualizer->draw(adjusted, ss.str().c_str());
@@ -140,27 +160,117 @@ void EvolutionaryCSCReducer::setup()
     if (mapping.contains(adjacentSource)) m_adjacentSourceVertices.insert(adjacentSource);
   });
 
-  // Prepare intial "m_adjacentSources" adjacency list
-  for (vertex_t target : m_bestSuperVertex) prepareVertex(target, m_temporary, false);
-
+  setupRegion();
+  setupRegionData();
   m_bestFitness = getFitness(m_bestSuperVertex);
-  initializePopulations();
 }
 
-void EvolutionaryCSCReducer::initializePopulations()
+void EvolutionaryCSCReducer::setupRegion()
 {
-  m_populationA.resize(POPULATION_SIZE);
-  m_populationB.resize(POPULATION_SIZE);
+  // breadth-first search through free target vertices starting at the initial super vertex
+  Vector<fuint32_t> depth{};
+  fuint32_t maxSize = std::max(m_config.m_maxRegionSize, (fuint32_t)m_bestSuperVertex.size());
+  auto addLocal = [&](vertex_t target, fuint32_t d){
+    m_localIndex.insert(std::make_pair(target, (fuint32_t)m_localVertices.size()));
+    m_localVertices.push_back(target);
+    depth.push_back(d);
+  };
 
-  for (auto& individual : m_populationA)
+  for (vertex_t target : m_bestSuperVertex) addLocal(target, 0);
+  for (fuint32_t idx = 0; idx < m_localVertices.size() && m_localVertices.size() < maxSize; ++idx)
   {
-    individual.initialize(*this, m_sourceVertex);
-    individual.fromInitial(m_bestSuperVertex); // at this point m_bestSuperVertex is initial placement
+    if (depth[idx] >= m_config.m_regionRadius) continue;
+    fuint32_t nextDepth = depth[idx] + 1;
+    m_state.iterateFreeTargetAdjacent(m_localVertices[idx], [&](vertex_t adjacent){
+      if (m_localVertices.size() < maxSize && !m_localIndex.contains(adjacent)) addLocal(adjacent, nextDepth);
+    });
   }
-  for (auto& individual : m_populationB)
+
+  m_nbWords = (m_localVertices.size() + 63) / 64;
+  m_initialBits.assign(m_nbWords, 0);
+  for (fuint32_t idx = 0; idx < m_bestSuperVertex.size(); ++idx)
+  {
+    m_initialBits[idx >> 6] |= (uint64_t)1 << (idx & 63);
+  }
+}
+
+void EvolutionaryCSCReducer::setupRegionData()
+{
+  const auto& remaining = m_state.getRemainingTargetNodes();
+  Vector<vertex_t> adjacentSources(m_adjacentSourceVertices.begin(), m_adjacentSourceVertices.end());
+  UnorderedMap<vertex_t, fuint32_t> sourceIndex{};
+  for (fuint32_t idx = 0; idx < adjacentSources.size(); ++idx)
   {
-    individual.initialize(*this, m_sourceVertex);
+    sourceIndex.insert(std::make_pair(adjacentSources[idx], idx));
   }
+
+  fuint32_t n = m_localVertices.size();
+  m_localAdjOffsets.assign(1, 0);
+  m_localSourceOffsets.assign(1, 0);
+  m_localFree.resize(n);
+  m_localFitness.resize(n);
+  fuint32_t maxFitness = 0;
+  Vector<fuint32_t> sources{};
+  for (fuint32_t idx = 0; idx < n; ++idx)
+  {
+    vertex_t target = m_localVertices[idx];
+    m_state.iterateTargetGraphAdjacent(target, [&](vertex_t adjacent){
+      auto findIt = m_localIndex.find(adjacent);
+      if (findIt != m_localIndex.end()) m_localAdj.push_back(findIt->second);
+    });
+    m_localAdjOffsets.push_back(m_localAdj.size());
+
+    // adjacent source vertices a super vertex containing "target" is connected to
+    sources.clear();
+    auto addSource = [&](vertex_t source){
+      auto findIt = sourceIndex.find(source);
+      if (findIt != sourceIndex.end()) sources.push_back(findIt->second);
+    };
+    m_state.iterateTargetAdjacentReverseMapping(target, addSource);
+    m_state.iterateReverseMapping(target, addSource);
+    std::sort(sources.begin(), sources.end());
+    sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+    m_localSources.insert(m_localSources.end(), sources.begin(), sources.end());
+    m_localSourceOffsets.push_back(m_localSources.size());
+
+    m_localFree[idx] = remaining.contains(target);
+    auto fitnessIt = m_vertexFitness.find(target);
+    m_localFitness[idx] = fitnessIt == m_vertexFitness.end() ? 0 : fitnessIt->second;
+    setMax(maxFitness, m_localFitness[idx]);
+  }
+
+  fuint32_t nbPlanes = std::bit_width(maxFitness);
+  m_fitnessPlanes.assign(nbPlanes, Vector<uint64_t>(m_nbWords, 0));
+  for (fuint32_t idx = 0; idx < n; ++idx)
+  {
+    for (fuint32_t plane = 0; plane < nbPlanes; ++plane)
+    {
+      if ((m_localFitness[idx] >> plane) & 1) m_fitnessPlanes[plane][idx >> 6] |= (uint64_t)1 << (idx & 63);
+    }
+  }
+}
+
+void EvolutionaryCSCReducer::initializePopulations()
+{
+  fuint32_t populationSize = std::max(m_config.m_populationSize, (fuint32_t)1);
+  m_populationA.resize(populationSize);
+  m_populationB.resize(populationSize);
+
+  // every individual draws from its own stream of the reducer's seed
+  runParallel(populationSize, "individual", [&](fuint32_t idx){
+    auto& individual = m_populationA[idx];
+    individual.initialize(*this, deriveSeed(m_seed, 2 * idx + 1));
+    individual.fromInitial();
+    m_populationB[idx].initialize(*this, deriveSeed(m_seed, 2 * idx + 2));
+  });
+}
+
+bool EvolutionaryCSCReducer::budgetExhausted() const
+{
+  if (m_config.m_evaluationBudget != 0 && m_evaluations >= m_config.m_evaluationBudget) return true;
+  if (m_config.m_timeBudgetMs == 0) return false;
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start);
+  return (fuint32_t)elapsed.count() >= m_config.m_timeBudgetMs;
 }
 
 bool EvolutionaryCSCReducer::canExpand()
@@ -187,16 +297,7 @@ bool EvolutionaryCSCReducer::canExpand()
 void EvolutionaryCSCReducer::optimizeIteration(Vector<CSCIndividual>& parentPopulation)
 {
   // optimize all in parent population
-  #define MULTITHREADED 1
-  #if MULTITHREADED == 1
-  for (auto& parent : parentPopulation)
-  {
-    m_threadManager.run( [&]() { parent.optimize(); });
-  }
-  m_threadManager.wait();
-  #else
-  for (auto& parent : parentPopulation) parent.optimize();
-  #endif
+  runParallel(parentPopulation.size(), "individual", [&](fuint32_t idx) { parentPopulation[idx].optimize(); });
   // sort parent population
   std::sort(parentPopulation.begin(), parentPopulation.end(), std::less<CSCIndividual>());
 
@@ -207,8 +308,7 @@ void EvolutionaryCSCReducer::optimizeIteration(Vector<CSCIndividual>& parentPopu
   { // adopt new superior solution
     m_bestFitness = newBestFitness;
     m_bestSuperVertex.clear();
-    const auto& newSuperVertex = parentPopulation[0].getSuperVertex();
-    m_bestSuperVertex.insert(newSuperVertex.begin(), newSuperVertex.end());
+    parentPopulation[0].getSuperVertex(m_bestSuperVertex);
     m_improved = true;
   }
 }
@@ -216,66 +316,49 @@ void EvolutionaryCSCReducer::optimizeIteration(Vector<CSCIndividual>& parentPopu
 bool EvolutionaryCSCReducer::createNextGeneration(Vector<CSCIndividual>& parentPopulation,
   Vector<CSCIndividual>& childPopulation)
 {
-  fuint32_t remainingAttemps = 5 * POPULATION_SIZE;
-  for (fuint32_t idx = 3; idx < POPULATION_SIZE && remainingAttemps > 0; --remainingAttemps)
-  {
-    const CSCIndividual* parentA = tournamentSelection(parentPopulation);
-    const CSCIndividual* parentB = tournamentSelection(parentPopulation);
-    bool success = childPopulation[idx].fromCrossover(*parentA, *parentB);
-    if (success) idx++;
-    // else std::cout << "Dead crossover!" << std::endl;
-  }
-  return remainingAttemps > 0;
-}
-
-const CSCIndividual* EvolutionaryCSCReducer::tournamentSelection(const Vector<CSCIndividual>& parentPopulation)
-{
-  fuint32_t max = POPULATION_SIZE - 1;
+  // parent population is sorted, so the first individuals are the elite
+  fuint32_t populationSize = parentPopulation.size();
+  fuint32_t eliteSize = std::min(m_config.m_eliteSize, populationSize);
+  for (fuint32_t idx = 0; idx < eliteSize; ++idx) childPopulation[idx].fromElite(parentPopulation[idx]);
 
-  const CSCIndividual* individualA = &parentPopulation.at(m_random.getRandomUint(max));
-  const CSCIndividual* individualB = &parentPopulation.at(m_random.getRandomUint(max));
-  return *individualA < *individualB ? individualA : individualB;
-}
+  m_crossoverSlots.clear();
+  for (fuint32_t idx = eliteSize; idx < populationSize; ++idx) m_crossoverSlots.push_back(idx);
 
-
-void EvolutionaryCSCReducer::prepareVertex(vertex_t target, nodeset_t& temp, bool count)
-{
-  if (!m_preparedVertices.contains(target))
+  // parents are selected sequentially, the crossovers run in parallel
+  fuint32_t remainingAttemps = 5 * populationSize;
+  while (!m_crossoverSlots.empty() && remainingAttemps > 0)
   {
-    temp.clear();
-    m_state.iterateTargetAdjacentReverseMapping(target,
-      [&](vertex_t adjacentSource){
-        if (m_adjacentSourceVertices.contains(adjacentSource)) temp.insert(adjacentSource);
-    });
-    m_state.iterateReverseMapping(target, [&](vertex_t source){
-        if (m_adjacentSourceVertices.contains(source)) temp.insert(source);
+    fuint32_t nbSlots = std::min((fuint32_t)m_crossoverSlots.size(), remainingAttemps);
+    remainingAttemps -= nbSlots;
+    m_crossoverParents.resize(nbSlots);
+    m_crossoverSuccess.assign(nbSlots, 0);
+    for (auto& parents : m_crossoverParents)
+    {
+      parents.first = tournamentSelection(parentPopulation);
+      parents.second = tournamentSelection(parentPopulation);
+    }
+    runParallel(nbSlots, "crossover", [&](fuint32_t idx){
+      const auto& parents = m_crossoverParents[idx];
+      m_crossoverSuccess[idx] = childPopulation[m_crossoverSlots[idx]].fromCrossover(*parents.first, *parents.second);
     });
-  }
 
-  m_prepareLock.lock();
-  if (!m_preparedVertices.contains(target))
-  {
-    for (vertex_t source : temp)
+    fuint32_t remaining = 0;
+    for (fuint32_t idx = 0; idx < m_crossoverSlots.size(); ++idx)
     {
-      m_adjacentSources.insert(std::make_pair(target, source));
+      if (idx >= nbSlots || !m_crossoverSuccess[idx]) m_crossoverSlots[remaining++] = m_crossoverSlots[idx];
     }
-    const auto& reverse = m_state.getReverseMapping();
-    if (count) m_vertexFitness.insert(std::make_pair(target, reverse.count(target)));
-    m_preparedVertices.insert(target);
+    m_crossoverSlots.resize(remaining);
   }
-  m_prepareLock.unlock();
-  temp.clear();
+  return m_crossoverSlots.empty();
 }
 
-void EvolutionaryCSCReducer::addConnectivity(VertexNumberMap& connectivity, nodeset_t& temp, vertex_t target)
+const CSCIndividual* EvolutionaryCSCReducer::tournamentSelection(const Vector<CSCIndividual>& parentPopulation)
 {
-  if (!m_preparedVertices.contains(target)) prepareVertex(target, temp);
+  fuint32_t max = parentPopulation.size() - 1;
 
-  auto range = m_adjacentSources.equal_range(target);
-  for (auto it = range.first; it != range.second; ++it)
-  {
-    connectivity[it->second]++;
-  }
+  const CSCIndividual* individualA = &parentPopulation.at(m_random.getRandomUint(max));
+  const CSCIndividual* individualB = &parentPopulation.at(m_random.getRandomUint(max));
+  return *individualA < *individualB ? individualA : individualB;
 }
 
 size_t EvolutionaryCSCReducer::getFitness(const nodeset_t& placement) const
@@ -290,113 +373,135 @@ size_t EvolutionaryCSCReducer::getFitness(const nodeset_t& placement) const
   return fitness;
 }
 
-size_t EvolutionaryCSCReducer::getFitness(vertex_t target) const
-{
-  auto findIt = m_vertexFitness.find(target);
-  return findIt == m_vertexFitness.end() ? 0 : findIt->second;
-}
-
-bool EvolutionaryCSCReducer::isRemoveable(VertexNumberMap& connectivity, vertex_t target) const
+// weighted popcount: the fitness of a local vertex is split into bit planes
+size_t EvolutionaryCSCReducer::getFitness(const Vector<uint64_t>& bits) const
 {
-  auto range = m_adjacentSources.equal_range(target);
-  for (auto it = range.first; it != range.second; ++it)
+  size_t fitness = 0;
+  for (fuint32_t plane = 0; plane < m_fitnessPlanes.size(); ++plane)
   {
-    if (connectivity[it->second] <= 1) return false;
+    const auto& mask = m_fitnessPlanes[plane];
+    size_t count = 0;
+    for (fuint32_t word = 0; word < m_nbWords; ++word) count += std::popcount(bits[word] & mask[word]);
+    fitness += count << plane;
   }
-  return true;
+  return fitness;
 }
 
-void EvolutionaryCSCReducer::removeVertex(VertexNumberMap& connectivity, vertex_t target) const
+bool EvolutionaryCSCReducer::areAdjacent(const Vector<uint64_t>& bitsA, const Vector<uint64_t>& bitsB) const
 {
-  auto range = m_adjacentSources.equal_range(target);
-  for (auto it = range.first; it != range.second; ++it)
-  {
-    auto findIt = connectivity.find(it->second);
-    if (findIt != connectivity.end()) findIt->second--;
-  }
+  bool adjacent = false;
+  iterateBits(bitsA, [&](fuint32_t local){
+    if (adjacent) return;
+    for (fuint32_t idx = m_localAdjOffsets[local]; idx < m_localAdjOffsets[local + 1]; ++idx)
+    {
+      fuint32_t other = m_localAdj[idx];
+      if ((bitsB[other >> 6] >> (other & 63)) & 1)
+      {
+        adjacent = true;
+        return;
+      }
+    }
+  });
+  return adjacent;
 }
 
 bool CSCIndividual::isConnected() const
 {
-  for (const auto& connect : m_connectivity)
+  for (auto connect : m_connectivity)
   {
-    if (connect.second == 0) return false;
+    if (connect == 0) return false;
   }
   return true;
 }
 
-void CSCIndividual::initialize(EvolutionaryCSCReducer& reducer, vertex_t sourceVertex)
+void CSCIndividual::initialize(EvolutionaryCSCReducer& reducer, uint64_t seed)
 {
   m_reducer = &reducer;
-  m_state = &reducer.m_state;
-  m_sourceVertex = sourceVertex;
-  m_random = std::make_unique<RandomGen>();
+  m_random.seed(seed);
+  m_bits.assign(reducer.m_nbWords, 0);
+  m_connectivity.assign(reducer.m_adjacentSourceVertices.size(), 0);
+  m_visited.assign(reducer.m_localVertices.size(), 0);
 }
 
-
-
-void CSCIndividual::fromInitial(const nodeset_t& placement)
+void CSCIndividual::fromInitial()
 {
   m_done = false;
-  m_superVertex.clear();
-  m_superVertex.insert(placement.begin(), placement.end());
-
+  m_bits = m_reducer->m_initialBits;
   setupConnectivity();
 }
 
 bool CSCIndividual::fromCrossover(const CSCIndividual& individualA, const CSCIndividual& individualB)
 {
   m_done = false;
-  m_superVertex.clear();
-  const auto& superVertexA = individualA.getSuperVertex();
-  const auto& superVertexB = individualB.getSuperVertex();
-  // std::cout << "Crossover: overlapping - " << overlappingSets(superVertexA, superVertexB) << "; connected - "
-  //   << areSetsConnected(*m_state, superVertexA, superVertexB) << std::endl;
-  if (!overlappingSets(superVertexA, superVertexB)
-    && !areSetsConnected(*m_state, superVertexA, superVertexB))
+  const auto& bitsA = individualA.m_bits;
+  const auto& bitsB = individualB.m_bits;
+  bool overlapping = false;
+  for (fuint32_t word = 0; word < bitsA.size(); ++word) overlapping |= (bitsA[word] & bitsB[word]) != 0;
+  if (!overlapping && !m_reducer->areAdjacent(bitsA, bitsB))
   {
     m_done = true;
     return false;
   }
-  m_superVertex.insert(superVertexA.begin(), superVertexA.end());
-  m_superVertex.insert(superVertexB.begin(), superVertexB.end());
+  for (fuint32_t word = 0; word < bitsA.size(); ++word) m_bits[word] = bitsA[word] | bitsB[word];
   setupConnectivity();
   return true;
 }
 
-void CSCIndividual::printConnectivity() const
+void CSCIndividual::fromElite(const CSCIndividual& elite)
 {
-  printVertexNumberMap(m_connectivity);
+  m_bits = elite.m_bits;
+  m_connectivity = elite.m_connectivity;
+  m_size = elite.m_size;
+  m_fitness = elite.m_fitness;
+  m_done = true;
 }
 
-void CSCIndividual::setupConnectivity()
+void CSCIndividual::getSuperVertex(nodeset_t& superVertex) const
 {
-  const auto& adjacentSourceVertices = m_reducer->getAdjacentSourceVertices();
-  for (auto adjSource : adjacentSourceVertices)
-  {
-    m_connectivity[adjSource] = 0;
-  }
+  const auto& localVertices = m_reducer->m_localVertices;
+  iterateBits(m_bits, [&](fuint32_t local){ superVertex.insert(localVertices[local]); });
+}
 
-  for (auto target : m_superVertex)
+void CSCIndividual::printConnectivity() const
+{
+  for (fuint32_t idx = 0; idx < m_connectivity.size(); ++idx)
   {
-    m_reducer->addConnectivity(m_connectivity, m_temporarySet, target);
+    std::cout << idx << ": " << m_connectivity[idx] << std::endl;
   }
 }
 
+void CSCIndividual::setupConnectivity()
+{
+  std::fill(m_connectivity.begin(), m_connectivity.end(), 0);
+  const auto& offsets = m_reducer->m_localSourceOffsets;
+  const auto& sources = m_reducer->m_localSources;
+  m_size = 0;
+  iterateBits(m_bits, [&](fuint32_t local){
+    m_size++;
+    for (fuint32_t idx = offsets[local]; idx < offsets[local + 1]; ++idx) m_connectivity[sources[idx]]++;
+  });
+}
+
 void CSCIndividual::optimize()
 {
   if (m_done) return;
-  CHRONO_STUFF(t1,t2,diff1,TIME_MUTATION, mutate();)
-
-  CHRONO_STUFF(t3,t4,diff2, TIME_REDUCE, reduce();)
-  m_fitness = m_reducer->getFitness(m_superVertex);
+  m_reducer->m_evaluations++;
+  {
+    PROFILE_SCOPE(m_reducer->m_profiler, "mutate")
+    mutate();
+  }
+  {
+    PROFILE_SCOPE(m_reducer->m_profiler, "reduce")
+    reduce();
+  }
+  m_fitness = m_reducer->getFitness(m_bits);
   m_done = true;
 }
 
 
 size_t CSCIndividual::getSolutionSize() const
 {
-  return m_superVertex.size();
+  return m_size;
 }
 
 size_t CSCIndividual::getFitness() const
@@ -404,69 +509,76 @@ size_t CSCIndividual::getFitness() const
   return m_fitness;
 }
 
-void CSCIndividual::mutate()
+fuint32_t CSCIndividual::nextVisitStamp()
 {
-  m_temporarySet.clear();
-  for (vertex_t vertex : m_superVertex)
+  if (++m_visitStamp == 0)
   {
-    m_state->iterateFreeTargetAdjacent(vertex,
-      [&](vertex_t adjacentTarget){
-        if(!m_superVertex.contains(adjacentTarget))
-        {
-          m_temporarySet.insert(adjacentTarget);
-        }
-    });
+    std::fill(m_visited.begin(), m_visited.end(), 0);
+    m_visitStamp = 1;
   }
-  if (m_temporarySet.empty()) return;
+  return m_visitStamp;
+}
 
-  vertex_t startVertex = m_random->getRandomVertex(m_temporarySet);
+void CSCIndividual::mutate()
+{
+  const auto& offsets = m_reducer->m_localAdjOffsets;
+  const auto& adjacency = m_reducer->m_localAdj;
+  const auto& free = m_reducer->m_localFree;
 
-  if (!isDefined(startVertex)) return;
-  m_temporarySet.clear();
-  clearStack(m_iteratorStack);
+  // free vertices adjacent to the super vertex
+  fuint32_t stamp = nextVisitStamp();
+  m_vertexVector.clear();
+  iterateBits(m_bits, [&](fuint32_t local){
+    for (fuint32_t idx = offsets[local]; idx < offsets[local + 1]; ++idx)
+    {
+      fuint32_t adjacent = adjacency[idx];
+      if (free[adjacent] && !contains(adjacent) && m_visited[adjacent] != stamp)
+      {
+        m_visited[adjacent] = stamp;
+        m_vertexVector.push_back(adjacent);
+      }
+    }
+  });
+  if (m_vertexVector.empty()) return;
 
-  const auto& targetGraph = m_state->getTargetAdjGraph();
-  const auto& remaining = m_state->getRemainingTargetNodes();
+  fuint32_t startVertex = m_random.getRandomElement(m_vertexVector);
 
   fuint32_t numberAdded = 1;
   addVertex(startVertex);
-  m_iteratorStack.push(targetGraph.equal_range(startVertex));
-  while(!m_iteratorStack.empty() && numberAdded <= MAX_NEW_VERTICES)
+  m_stack.clear();
+  m_stack.push_back(std::make_pair(startVertex, offsets[startVertex]));
+  while(!m_stack.empty() && numberAdded <= m_reducer->m_config.m_maxNewVertices)
   {
-    auto& top = m_iteratorStack.top();
-    if (top.first == top.second)
+    auto& top = m_stack.back();
+    if (top.second == offsets[top.first + 1])
     {
-      m_iteratorStack.pop();
+      m_stack.pop_back();
       continue;
     }
-    vertex_t adjacent = top.first->second;
-    if (remaining.contains(adjacent) && !m_superVertex.contains(adjacent))
+    fuint32_t adjacent = adjacency[top.second++];
+    if (free[adjacent] && !contains(adjacent))
     { // add node
-      top.first++;
       addVertex(adjacent);
       numberAdded++;
-      m_iteratorStack.push(targetGraph.equal_range(adjacent));
-    }
-    else
-    {
-      top.first++;
+      m_stack.push_back(std::make_pair(adjacent, offsets[adjacent]));
     }
   }
 }
 
 void CSCIndividual::reduce()
 {
-  if (m_superVertex.size() <= 1) return;
-  m_vertexVector.resize(m_superVertex.size());
-  fuint32_t idx = 0;
-  for (vertex_t vertex : m_superVertex) m_vertexVector[idx++] = vertex;
+  if (m_size <= 1) return;
+  m_vertexVector.clear();
+  iterateBits(m_bits, [&](fuint32_t local){ m_vertexVector.push_back(local); });
   fuint32_t vectorSize = m_vertexVector.size();
+  const auto& localFitness = m_reducer->m_localFitness;
 
   // Try greedily reducing overlap vertices
+  fuint32_t idx;
   for (idx = 0; idx < vectorSize;)
   {
-    vertex_t* current = &m_vertexVector[idx];
-    if (m_reducer->getFitness(*current) != 0 && tryRemove(*current))
+    fuint32_t* current = &m_vertexVector[idx];
+    if (localFitness[*current] != 0 && tryRemove(*current))
     {
       *current = m_vertexVector.back();
       m_vertexVector.resize(--vectorSize);
@@ -475,13 +587,13 @@ void CSCIndividual::reduce()
   }
 
   // Try reducing all other vertices
-  fuint32_t maxIterations = REDUCE_ITERATION_COEFFICIENT * m_vertexVector.size();
+  fuint32_t maxIterations = m_reducer->m_config.m_reduceIterationCoefficient * m_vertexVector.size();
   vectorSize = m_vertexVector.size();
-  for (fuint32_t iteration = 0; iteration < maxIterations; ++iteration)
+  for (fuint32_t iteration = 0; iteration < maxIterations && vectorSize > 0; ++iteration)
   {
-    fuint32_t randomIdx = m_random->getRandomUint(vectorSize - 1);
-    vertex_t* current = &m_vertexVector[randomIdx];
-    if (!m_superVertex.contains(*current) || tryDfsRemove(*current, iteration))
+    fuint32_t randomIdx = m_random.getRandomUint(vectorSize - 1);
+    fuint32_t* current = &m_vertexVector[randomIdx];
+    if (!contains(*current) || tryDfsRemove(*current, iteration))
     {
       *current = m_vertexVector.back();
       m_vertexVector.resize(--vectorSize);
@@ -490,55 +602,113 @@ void CSCIndividual::reduce()
 
   for (idx = 0; idx < vectorSize; ++idx)
   {
-    if (m_superVertex.contains(m_vertexVector[idx])) tryRemove(m_vertexVector[idx]);
+    if (contains(m_vertexVector[idx])) tryRemove(m_vertexVector[idx]);
   }
 }
 
-void CSCIndividual::addVertex(vertex_t target)
+void CSCIndividual::addVertex(fuint32_t local)
 {
-  if (m_superVertex.contains(target)) return;
-  m_reducer->addConnectivity(m_connectivity, m_temporarySet, target);
-  m_superVertex.insert(target);
+  if (contains(local)) return;
+  m_bits[local >> 6] |= (uint64_t)1 << (local & 63);
+  m_size++;
+  const auto& offsets = m_reducer->m_localSourceOffsets;
+  const auto& sources = m_reducer->m_localSources;
+  for (fuint32_t idx = offsets[local]; idx < offsets[local + 1]; ++idx) m_connectivity[sources[idx]]++;
 }
 
-bool CSCIndividual::tryRemove(vertex_t target)
+void CSCIndividual::removeVertex(fuint32_t local)
 {
-  // Remove if not a cut vertex
-  if (!m_reducer->isRemoveable(m_connectivity, target)) return false;
+  m_bits[local >> 6] &= ~((uint64_t)1 << (local & 63));
+  m_size--;
+  const auto& offsets = m_reducer->m_localSourceOffsets;
+  const auto& sources = m_reducer->m_localSources;
+  for (fuint32_t idx = offsets[local]; idx < offsets[local + 1]; ++idx) m_connectivity[sources[idx]]--;
+}
 
-  m_temporarySet.clear();
-  m_temporarySet.insert(m_superVertex.begin(), m_superVertex.end());
-  if (!isCutVertex(*m_state, m_temporarySet, target))
+bool CSCIndividual::isRemoveable(fuint32_t local) const
+{
+  const auto& offsets = m_reducer->m_localSourceOffsets;
+  const auto& sources = m_reducer->m_localSources;
+  for (fuint32_t idx = offsets[local]; idx < offsets[local + 1]; ++idx)
   {
-    m_reducer->removeVertex(m_connectivity, target);
-    m_superVertex.unsafe_erase(target);
-    return true;
+    if (m_connectivity[sources[idx]] <= 1) return false;
   }
-  m_temporarySet.clear();
-  return false;
+  return true;
+}
+
+// Depth-first search through the super vertex without "local".
+// If not all other vertices are reached, "local" is a cut vertex.
+bool CSCIndividual::isCutVertex(fuint32_t local)
+{
+  if (m_size <= 1) return true;
+  const auto& offsets = m_reducer->m_localAdjOffsets;
+  const auto& adjacency = m_reducer->m_localAdj;
+
+  fuint32_t root = FUINT32_UNDEF;
+  for (fuint32_t idx = offsets[local]; idx < offsets[local + 1]; ++idx)
+  {
+    if (contains(adjacency[idx]))
+    {
+      root = adjacency[idx];
+      break;
+    }
+  }
+  if (!isDefined(root)) return true;
+
+  fuint32_t stamp = nextVisitStamp();
+  m_visited[local] = stamp;
+  m_visited[root] = stamp;
+  fuint32_t reached = 1;
+  m_stack.clear();
+  m_stack.push_back(std::make_pair(root, offsets[root]));
+  while (!m_stack.empty())
+  {
+    auto& top = m_stack.back();
+    if (top.second == offsets[top.first + 1])
+    {
+      m_stack.pop_back();
+      continue;
+    }
+    fuint32_t adjacent = adjacency[top.second++];
+    if (m_visited[adjacent] != stamp && contains(adjacent))
+    {
+      m_visited[adjacent] = stamp;
+      if (++reached == m_size - 1) return false;
+      m_stack.push_back(std::make_pair(adjacent, offsets[adjacent]));
+    }
+  }
+  return reached < m_size - 1;
+}
+
+bool CSCIndividual::tryRemove(fuint32_t local)
+{
+  // Remove if not a cut vertex
+  if (!isRemoveable(local) || isCutVertex(local)) return false;
+  removeVertex(local);
+  return true;
 }
 
-bool CSCIndividual::tryDfsRemove(vertex_t target, fuint32_t& iteration)
+bool CSCIndividual::tryDfsRemove(fuint32_t local, fuint32_t& iteration)
 {
-  if (!tryRemove(target)) return false;
+  if (!tryRemove(local)) return false;
 
-  const auto& targetGraph = m_state->getTargetAdjGraph();
-  clearStack(m_iteratorStack);
-  m_iteratorStack.push(targetGraph.equal_range(target));
-  while(!m_iteratorStack.empty())
+  const auto& offsets = m_reducer->m_localAdjOffsets;
+  const auto& adjacency = m_reducer->m_localAdj;
+  auto& dfsStack = m_dfsStack;
+  dfsStack.clear();
+  dfsStack.push_back(std::make_pair(local, offsets[local]));
+  while(!dfsStack.empty())
   {
-    auto& top = m_iteratorStack.top();
-    if (top.first == top.second) m_iteratorStack.pop();
-    else if (m_superVertex.contains(top.first->second))
+    auto& top = dfsStack.back();
+    if (top.second == offsets[top.first + 1]) dfsStack.pop_back();
+    else
     {
-      vertex_t adjacent = top.first->second;
-      top.first++;
+      fuint32_t adjacent = adjacency[top.second++];
+      if (!contains(adjacent)) continue;
       iteration++;
       bool success = tryRemove(adjacent);
-      if (success) m_iteratorStack.push(targetGraph.equal_range(adjacent));
+      if (success) dfsStack.push_back(std::make_pair(adjacent, offsets[adjacent]));
     }
-    else top.first++;
   }
   return true;
 }
-
@@ -3,32 +3,45 @@
 
 #include <majorminer_types.hpp>
 #include <common/random_gen.hpp>
+#include <common/embedding_config.hpp>
+#include <common/thread_manager.hpp>
+#include <common/time_measurement.hpp>
+
+#include <chrono>
 
 namespace majorminer
 {
 
+  // A super vertex inside the candidate region of its reducer. The target
+  // vertices are stored as a bitset over the dense local index of the region.
   class CSCIndividual
   {
     friend EvolutionaryCSCReducer;
     public:
-      CSCIndividual(): m_reducer(nullptr), m_done(false) {}
+      CSCIndividual(): m_reducer(nullptr), m_size(0), m_fitness(0), m_visitStamp(0), m_done(false) {}
 
-      void initialize(EvolutionaryCSCReducer& reducer, vertex_t sourceVertex);
+      void initialize(EvolutionaryCSCReducer& reducer, uint64_t seed);
 
-      void fromInitial(const nodeset_t& placement);
+      void fromInitial();
       bool fromCrossover(const CSCIndividual& individualA, const CSCIndividual& individualB);
+      void fromElite(const CSCIndividual& elite);
       void optimize();
-      const nodeset_t& getSuperVertex() const { return m_superVertex; }
+      void getSuperVertex(nodeset_t& superVertex) const;
       bool isConnected() const;
       void printConnectivity() const;
 
     private:
-      void addVertex(vertex_t target);
-      bool tryRemove(vertex_t target);
-      bool tryDfsRemove(vertex_t target, fuint32_t& iteration);
+      bool contains(fuint32_t local) const { return (m_bits[local >> 6] >> (local & 63)) & 1; }
+      void addVertex(fuint32_t local);
+      void removeVertex(fuint32_t local);
+      bool isRemoveable(fuint32_t local) const;
+      bool isCutVertex(fuint32_t local);
+      bool tryRemove(fuint32_t local);
+      bool tryDfsRemove(fuint32_t local, fuint32_t& iteration);
       void mutate();
       void reduce();
       void setupConnectivity();
+      fuint32_t nextVisitStamp();
       size_t getSolutionSize() const;
       size_t getFitness() const;
 
@@ -41,16 +54,17 @@ namespace majorminer
 
     private:
       EvolutionaryCSCReducer* m_reducer;
-      const EmbeddingState* m_state;
-      vertex_t m_sourceVertex;
-      nodeset_t m_superVertex;
-      VertexNumberMap m_connectivity;
+      Vector<uint64_t> m_bits;
+      Vector<fuint32_t> m_connectivity; // indexed by the adjacent source vertices
+      fuint32_t m_size;
       size_t m_fitness;
 
-      nodeset_t m_temporarySet;
-      Stack<adjacency_list_range_iterator_t> m_iteratorStack;
-      Vector<vertex_t> m_vertexVector;
-      std::unique_ptr<RandomGen> m_random;
+      Vector<fuint32_t> m_vertexVector;
+      Vector<fuint32_t> m_visited;
+      Vector<fuint32_pair_t> m_stack;
+      Vector<fuint32_pair_t> m_dfsStack;
+      fuint32_t m_visitStamp;
+      RandomGen m_random;
 
       bool m_done;
   };
@@ -63,58 +77,109 @@ namespace majorminer
       EvolutionaryCSCReducer(EmbeddingState& state, const nodeset_t& initial, vertex_t sourceVertex);
 
       void setVisualizer(EmbeddingVisualizer* vis) { m_visualizer = vis; }
+      // disable when the reducer itself runs inside a parallel batch
+      void setMultithreaded(bool multithreaded) { m_multithreaded = multithreaded; }
+      void setSeed(uint64_t seed) { m_seed = seed; }
       void optimize();
       const nodeset_t& getPlacement() const { return m_bestSuperVertex; }
       bool foundBetter() const { return m_improved; }
+      // individuals optimized and wall time of the last call to optimize
+      fuint32_t getNbEvaluations() const { return m_evaluations; }
+      double getElapsedMs() const { return m_elapsedMs; }
+      // true if the last call to optimize stopped because a budget was exhausted
+      bool stoppedByBudget() const { return m_stoppedByBudget; }
 
     private:
       void initialize();
       void initialize(const nodeset_t& initial);
       void setup();
+      void setupRegion();
+      void setupRegionData();
       bool canExpand();
+      bool budgetExhausted() const;
       void initializePopulations();
       void optimizeIteration(Vector<CSCIndividual>& parentPopulation);
       bool createNextGeneration(Vector<CSCIndividual>& parentPopulation, Vector<CSCIndividual>& childPopulation);
-      void prepareVertex(vertex_t target, nodeset_t& temp, bool count = true);
       const CSCIndividual* tournamentSelection(const Vector<CSCIndividual>& parentPopulation);
       void visualize(fuint32_t iteration, Vector<CSCIndividual>* population);
 
+      template<typename Functor>
+      void runParallel(fuint32_t n, [[maybe_unused]] const char* label, const Functor& func)
+      {
+        if (!m_multithreaded || n <= 1)
+        {
+          for (fuint32_t idx = 0; idx < n; ++idx)
+          {
+            PROFILE_SCOPE(m_profiler, label)
+            func(idx);
+          }
+          return;
+        }
+        PROFILE_CONTEXT(m_profiler, context)
+        for (fuint32_t idx = 0; idx < n; ++idx)
+        {
+          m_threadManager.run([&, idx]() {
+            PROFILE_SCOPE(m_profiler, label, context)
+            func(idx);
+          });
+        }
+        m_threadManager.wait();
+      }
+
     private: // called mainly by CSCIndividual
-      void addConnectivity(VertexNumberMap& connectivity, nodeset_t& temp, vertex_t target);
-      bool isRemoveable(VertexNumberMap& connectivity, vertex_t target) const;
-      void removeVertex(VertexNumberMap& connectivity, vertex_t target) const;
-      size_t getFitness(vertex_t target) const;
       size_t getFitness(const nodeset_t& placement) const;
-      const nodeset_t& getAdjacentSourceVertices() const { return m_adjacentSourceVertices; }
+      size_t getFitness(const Vector<uint64_t>& bits) const;
+      bool areAdjacent(const Vector<uint64_t>& bitsA, const Vector<uint64_t>& bitsB) const;
 
     private:
       const EmbeddingState& m_state;
+      const EvolutionaryConfig& m_config;
       vertex_t m_sourceVertex;
       bool m_wasPlaced;
       bool m_expansionPossible;
       bool m_improved;
+      bool m_multithreaded;
 
       EmbeddingVisualizer* m_visualizer;
       ThreadManager& m_threadManager;
+      Profiler& m_profiler;
 
       Vector<CSCIndividual> m_populationA;
       Vector<CSCIndividual> m_populationB;
-      adjacency_list_t m_adjacentSources;
       nodeset_t m_adjacentSourceVertices;
       VertexNumberMap m_vertexFitness;
-      nodeset_t m_preparedVertices;
+
+      // Candidate region: the initial super vertex and the free target vertices
+      // around it. Local indices are dense, the adjacency lists are stored as CSR.
+      Vector<vertex_t> m_localVertices;
+      UnorderedMap<vertex_t, fuint32_t> m_localIndex;
+      Vector<fuint32_t> m_localAdjOffsets;
+      Vector<fuint32_t> m_localAdj;
+      Vector<fuint32_t> m_localSourceOffsets;
+      Vector<fuint32_t> m_localSources;
+      Vector<char> m_localFree;
+      Vector<fuint32_t> m_localFitness;
+      Vector<Vector<uint64_t>> m_fitnessPlanes; // bit b of the fitness of each local vertex
+      Vector<uint64_t> m_initialBits;
+      fuint32_t m_nbWords;
 
       nodeset_t m_bestSuperVertex;
       size_t m_bestFitness;
 
-      nodeset_t m_temporary;
-      RandomGen m_random;
+      uint64_t m_seed;
+      std::chrono::steady_clock::time_point m_start;
+      std::atomic<fuint32_t> m_evaluations;
+      double m_elapsedMs;
+      bool m_stoppedByBudget;
+      Vector<fuint32_t> m_crossoverSlots;
+      Vector<std::pair<const CSCIndividual*, const CSCIndividual*>> m_crossoverParents;
+      Vector<char> m_crossoverSuccess;
 
-      std::mutex m_prepareLock;
+      RandomGen m_random;
   };
 
 }
 
 
 
-#endif
\ No newline at end of file
+#endif
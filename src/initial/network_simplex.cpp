@@ -5,15 +5,16 @@
 #include <common/utils.hpp>
 #include <common/time_measurement.hpp>
 
+#include <cmath>
+
 using namespace majorminer;
 
 #define PREVENT_TAKING 100
-#define OCCUPIED 10
-#define FREE 1
 
 
 NetworkSimplexWrapper::NetworkSimplexWrapper(EmbeddingState& state, EmbeddingManager& embeddingManager)
-  : m_state(state), m_embeddingManager(embeddingManager), m_initialized(false)
+  : m_state(state), m_embeddingManager(embeddingManager),
+    m_costConfig(state.getConfig().m_placementCosts), m_initialized(false)
 { }
 
 NetworkSimplexWrapper::capacity_t NetworkSimplexWrapper::getNumberAdjacentNodes(const adjacency_list_range_iterator_t& adjacentIt) const
@@ -34,6 +35,12 @@ void NetworkSimplexWrapper::constructLemonGraph()
   const auto& targetGraph = *m_state.getTargetGraph();
   for (const auto& arc : targetGraph)
   {
+    if (!m_state.isTargetEdgeActive(arc.first, arc.second))
+    { // ends of an inactive coupler are kept as long as they are active
+      if (m_state.isTargetVertexActive(arc.first)) createNode(arc.first);
+      if (m_state.isTargetVertexActive(arc.second)) createNode(arc.second);
+      continue;
+    }
     auto uNode = createNode(arc.first);
     auto vNode = createNode(arc.second);
     LemonArc uv = m_graph.addArc(uNode, vNode);
@@ -184,11 +191,12 @@ void NetworkSimplexWrapper::adjustCosts(vertex_t node, LemonArcMap<cost_t>& cost
   const auto& targetNodesRemaining = m_state.getRemainingTargetNodes();
   for (auto it = adjacentIt.first; it != adjacentIt.second; ++it)
   {
+    if (!m_state.isTargetEdgeActive(node, it->second)) continue;
     const auto& edges = getArcPair(node, it->second);
     if (targetNodesRemaining.contains(it->second))
     {
-      costs[edges.first] = FREE;
-      costs[edges.second] = FREE;
+      costs[edges.first] = m_costConfig.m_freeCost;
+      costs[edges.second] = m_costConfig.m_freeCost;
     }
     else
     {
@@ -218,13 +226,36 @@ NetworkSimplexWrapper::LemonNode NetworkSimplexWrapper::createNode(vertex_t node
   return findIt->second;
 }
 
-NetworkSimplexWrapper::cost_t NetworkSimplexWrapper::determineCost(vertex_t node)
+NetworkSimplexWrapper::cost_t NetworkSimplexWrapper::determineCost(vertex_t node) const
 {
-  return m_state.isNodeOccupied(node) ? OCCUPIED : FREE;
+  if (!m_state.isNodeOccupied(node)) return m_costConfig.m_freeCost;
+
+  // exponential in the number of chains overlapping on the node and linear
+  // in the length of the longest of these chains
+  const auto& mapping = m_state.getMapping();
+  auto range = m_state.getReverseMapping().equal_range(node);
+  fuint32_t overlaps = 0;
+  fuint32_t longestChain = 0;
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    overlaps++;
+    longestChain = std::max(longestChain, (fuint32_t)mapping.count(it->second));
+  }
+
+  double cost = m_costConfig.m_occupiedCost * std::pow(m_costConfig.m_overlapBase, std::max(overlaps, (fuint32_t)1) - 1)
+    + m_costConfig.m_chainLengthWeight * longestChain;
+  return (cost_t)std::min(cost, (double)m_costConfig.m_maxCost);
 }
 
 void NetworkSimplexWrapper::setupCostsAndCaps()
 {
+  // costs only depend on the tail vertex, so evaluate each vertex once
+  m_nodeCosts.clear();
+  for (const auto& node : m_nodeMap)
+  {
+    m_nodeCosts[node.first] = determineCost(node.first);
+  }
+
   // set all costs of nonartificial arcs
   for (const auto& edgePair : m_edgeMap)
   {
@@ -232,8 +263,8 @@ void NetworkSimplexWrapper::setupCostsAndCaps()
     const auto& vu = edgePair.second.second;
     (*m_capMap)[uv] = m_numberAdjacent;
     (*m_capMap)[vu] = m_numberAdjacent;
-    (*m_costMap)[uv] = determineCost(edgePair.first.first);
-    (*m_costMap)[vu] = determineCost(edgePair.first.second);
+    (*m_costMap)[uv] = m_nodeCosts[edgePair.first.first];
+    (*m_costMap)[vu] = m_nodeCosts[edgePair.first.second];
   }
 }
 
@@ -5,6 +5,7 @@
 #include <lemon/network_simplex.h>
 
 #include <majorminer_types.hpp>
+#include <common/embedding_config.hpp>
 
 namespace majorminer
 {
@@ -25,11 +26,12 @@ namespace majorminer
 
       void embeddNode(vertex_t node);
       const nodeset_t& getMapped() const { return m_mapped; }
+      // cost of placing the node on the target vertex, see PlacementCostConfig
+      cost_t determineCost(vertex_t node) const;
 
     private:
       void initialCreation();
       LemonNode createNode(vertex_t node);
-      cost_t determineCost(vertex_t node);
       void adjustCosts(vertex_t node, LemonArcMap<cost_t>& costs);
       void setupCostsAndCaps();
 
@@ -55,6 +57,8 @@ namespace majorminer
       UnorderedMap<vertex_t, LemonNode> m_nodeMap;
       UnorderedMap<edge_t, LemonArcPair, PairHashFunc<vertex_t>> m_edgeMap;
       UnorderedSet<vertex_t> m_mapped;
+      UnorderedMap<vertex_t, cost_t> m_nodeCosts;
+      const PlacementCostConfig& m_costConfig;
 
       std::unique_ptr<LemonArcMap<cost_t>> m_costMap;
       std::unique_ptr<LemonArcMap<capacity_t>> m_capMap;
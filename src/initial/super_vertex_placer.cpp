@@ -13,7 +13,7 @@
 using namespace majorminer;
 
 SuperVertexPlacer::SuperVertexPlacer(EmbeddingState& state, EmbeddingManager& embeddingManager)
-  : m_state(state), m_embeddingManager(embeddingManager)
+  : m_state(state), m_embeddingManager(embeddingManager), m_batchCounter(0)
 {}
 
 void SuperVertexPlacer::operator()()
@@ -32,24 +32,23 @@ void SuperVertexPlacer::replaceOverlapping()
 {
   std::cout << "Replace overlapping " << std::endl;
   nodeset_t overlapping{};
-  fuint32_t maxIterations = 5;
-  // const auto& sourceGraph = m_state.getSourceAdjGraph();
-
-  // nodeset_t temporary{};
+  Vector<vertex_t> pending{};
+  Vector<vertex_t> batch{};
+  Vector<vertex_t> rejected{};
+  fuint32_t maxIterations = m_state.getConfig().m_evolutionary.m_replaceIterations;
 
   for (fuint32_t idx = 0; idx < maxIterations; ++idx)
   {
     identifyOverlapping(overlapping);
     if (overlapping.empty()) break;
     std::cout << "Replace overlapping; iteration " << (idx + 1) << std::endl;
-    for (vertex_t vertex : overlapping)
+    pending.assign(overlapping.begin(), overlapping.end());
+    while (!pending.empty())
     {
-      improveMapping(vertex);
-      // replaceSuperVertex(vertex, temporary);
-
-      // visualize(vertex, PlacedNodeType::COMPLEX, sourceGraph.count(vertex));
+      selectIndependentBatch(pending, batch);
+      improveMappings(batch, rejected);
+      pending.insert(pending.end(), rejected.begin(), rejected.end());
     }
-
   }
 }
 
@@ -70,15 +69,90 @@ void SuperVertexPlacer::identifyOverlapping(nodeset_t& overlapping)
   }
 }
 
-void SuperVertexPlacer::improveMapping(vertex_t source)
+void SuperVertexPlacer::insertFootprint(vertex_t source, nodeset_t& footprint) const
+{
+  m_state.iterateSourceMappingAdjacent<false>(source, [&](vertex_t adjacent, vertex_t target){
+    footprint.insert(adjacent);
+    footprint.insert(target);
+    return false;
+  });
+}
+
+// Greedily moves a set of source vertices from "pending" to "batch" such that
+// no two of them are adjacent and their footprints (super vertex and its
+// target neighborhood) are disjoint. These can be optimized independently.
+void SuperVertexPlacer::selectIndependentBatch(Vector<vertex_t>& pending, Vector<vertex_t>& batch)
+{
+  batch.clear();
+  nodeset_t batchSources{};
+  nodeset_t blocked{};
+  nodeset_t footprint{};
+  fuint32_t remaining = 0;
+  for (vertex_t source : pending)
+  {
+    bool conflict = false;
+    m_state.iterateSourceGraphAdjacentBreak(source, [&](vertex_t adjacent){
+      conflict = batchSources.contains(adjacent);
+      return conflict;
+    });
+    if (!conflict)
+    {
+      footprint.clear();
+      insertFootprint(source, footprint);
+      conflict = overlappingSets(footprint, blocked);
+    }
+
+    if (conflict) pending[remaining++] = source;
+    else
+    {
+      batch.push_back(source);
+      batchSources.insert(source);
+      blocked.insert(footprint.begin(), footprint.end());
+    }
+  }
+  pending.resize(remaining);
+}
+
+// Optimizes all vertices of the batch in parallel on the unchanged state and
+// commits the improvements afterwards. An improvement is rejected if it takes
+// a target vertex another vertex of the batch has already claimed.
+void SuperVertexPlacer::improveMappings(const Vector<vertex_t>& batch, Vector<vertex_t>& rejected)
 {
-  EvolutionaryCSCReducer reducer{m_state, source};
+  rejected.clear();
+  uint64_t batchId = m_batchCounter++;
+  Vector<std::unique_ptr<EvolutionaryCSCReducer>> reducers(batch.size());
+  PROFILE_CONTEXT(m_state.getProfiler(), context)
+  tbb::parallel_for( tbb::blocked_range<size_t>(0, batch.size(), 1),
+    [&](const tbb::blocked_range<size_t>& range) {
+      for (auto idx = range.begin(); idx != range.end(); ++idx)
+      {
+        PROFILE_SCOPE(m_state.getProfiler(), "csc reducer", context)
+        reducers[idx] = std::make_unique<EvolutionaryCSCReducer>(m_state, batch[idx]);
+        reducers[idx]->setMultithreaded(batch.size() == 1);
+        reducers[idx]->setSeed(m_state.getTaskSeed(RandomStream::CSC_REDUCER, deriveSeed(batchId, batch[idx])));
+        reducers[idx]->optimize();
+      }
+  });
+
   const auto& sourceGraph = m_state.getSourceAdjGraph();
-  reducer.optimize();
-  if (reducer.foundBetter())
+  const auto& mapping = m_state.getMapping();
+  nodeset_t claimed{};
+  for (size_t idx = 0; idx < batch.size(); ++idx)
   {
+    if (!reducers[idx]->foundBetter()) continue;
+    vertex_t source = batch[idx];
+    const auto& superVertex = reducers[idx]->getPlacement();
+    if (overlappingSets(superVertex, claimed))
+    {
+      rejected.push_back(source);
+      continue;
+    }
+    for (vertex_t target : superVertex)
+    {
+      if (!containsPair(mapping, source, target)) claimed.insert(target);
+    }
+
     m_embeddingManager.unmapNode(source);
-    const auto& superVertex = reducer.getPlacement();
     m_embeddingManager.mapNode(source, superVertex);
     std::cout << "Improved through reducer. " << std::endl;
     if (m_state.hasVisualizer())
@@ -174,12 +248,20 @@ void SuperVertexPlacer::replaceSuperVertex(vertex_t source, nodeset_t& svertex)
 
 void SuperVertexPlacer::embeddNodeNetworkSimplex(vertex_t node, const nodeset_t* oldMapping)
 {
+  [[maybe_unused]] auto& profiler = m_state.getProfiler();
   if (m_nsWrapper.get() == nullptr) m_nsWrapper = std::make_unique<NetworkSimplexWrapper>(m_state, m_embeddingManager);
-  m_nsWrapper->embeddNode(node);
+  {
+    PROFILE_SCOPE(profiler, "network simplex")
+    m_nsWrapper->embeddNode(node);
+  }
 
   SuperVertexReducer reducer{m_state, node};
-  reducer.initialize(m_nsWrapper->getMapped());
-  reducer.optimize();
+  {
+    PROFILE_SCOPE(profiler, "super vertex reducer")
+    reducer.setSeed(m_state.getTaskSeed(RandomStream::PLACEMENT_REDUCER, node));
+    reducer.initialize(m_nsWrapper->getMapped());
+    reducer.optimize();
+  }
   const auto& superVertex = reducer.getBetterPlacement(m_nsWrapper->getMapped());
   fuint32_t fitness = calculateFitness(m_state, superVertex);
   if (oldMapping == nullptr)
@@ -20,7 +20,9 @@ namespace majorminer
 
     private:
       void identifyOverlapping(nodeset_t& overlapping);
-      void improveMapping(vertex_t source);
+      void selectIndependentBatch(Vector<vertex_t>& pending, Vector<vertex_t>& batch);
+      void improveMappings(const Vector<vertex_t>& batch, Vector<vertex_t>& rejected);
+      void insertFootprint(vertex_t source, nodeset_t& footprint) const;
       void trivialNode();
       bool connectedNode();
       void replaceSuperVertex(vertex_t source, nodeset_t& svertex);
@@ -40,6 +42,7 @@ namespace majorminer
       PrioNodeQueue m_nodesToProcess;
 
       std::unique_ptr<NetworkSimplexWrapper> m_nsWrapper;
+      fuint32_t m_batchCounter;
   };
 
 }
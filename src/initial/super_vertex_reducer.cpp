@@ -9,7 +9,7 @@
 using namespace majorminer;
 
 SuperVertexReducer::SuperVertexReducer(const EmbeddingBase& base, vertex_t sourceVertex)
-  : m_embedding(base), m_sourceVertex(sourceVertex), m_done(false)
+  : m_embedding(base), m_sourceVertex(sourceVertex), m_seed(nextStreamSeed()), m_done(false)
 { }
 
 void SuperVertexReducer::setup()
@@ -95,7 +95,7 @@ void SuperVertexReducer::clear()
 void SuperVertexReducer::optimize()
 {
   if (m_done) return;
-  RandomGen rand{};
+  RandomGen rand{m_seed};
   m_rand = &rand;
   fuint32_t maxIters = 8 * m_potentialNodes.size();
   fuint32_t halfMax = maxIters / 2;
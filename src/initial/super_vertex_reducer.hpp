@@ -12,6 +12,7 @@ namespace majorminer
       SuperVertexReducer(const EmbeddingBase& base, fuint32_t sourceVertex);
 
       void optimize();
+      void setSeed(uint64_t seed) { m_seed = seed; }
       const nodeset_t& getSuperVertex() const { return m_superVertex; }
       const nodeset_t& getInitialSuperVertex() const { return m_initialSuperVertex; }
       void initialize();
@@ -44,6 +45,7 @@ namespace majorminer
       std::unique_ptr<fuint32_t[]> m_verticesList;
 
       RandomGen* m_rand;
+      uint64_t m_seed;
 
       bool acceptOnlyReduction = false;
 
@@ -3,6 +3,7 @@
 
 #include <majorminer_types.hpp>
 #include <lmrp/lmrp_subgraph.hpp>
+#include <lmrp/lmrp_occupancy.hpp>
 #include <common/graph_info.hpp>
 
 namespace majorminer
@@ -11,7 +12,8 @@ namespace majorminer
   class ChimeraLMRPSubgraph : public LMRPSubgraph
   {
     public:
-      ChimeraLMRPSubgraph(ChimeraGraphInfo& g): m_graph(g) {}
+      ChimeraLMRPSubgraph(ChimeraGraphInfo& g)
+        : LMRPSubgraph(2), m_graph(g), m_occupied(g.getWidth(), g.getHeight()) {}
       ~ChimeraLMRPSubgraph() {}
 
       bool getSubgraph(vertex_t contained, nodeset_t& subgraph) override;
@@ -22,28 +24,32 @@ namespace majorminer
       void commit(vertex_t contained) override;
 
     private:
-      bool checkOccupation(fuint32_t x, fuint32_t y, vertex_t contained) const;
 
+      // The crater has m_craterSize x m_craterSize unit cells and extends to
+      // the side of the shore containing the vertex.
       template<typename Functor>
       void neighborhood(fuint32_t x, fuint32_t y, vertex_t contained, Functor func) const
       {
         bool leftSide = (contained & 0x04) == 0;
         auto width  = m_graph.getWidth();
         auto height = m_graph.getHeight();
+        fuint32_t size = m_craterSize;
 
-        fuint32_t minX = static_cast<fuint32_t>(std::max(static_cast<int>(x) - (leftSide ? 2 : 1), 0));
-        fuint32_t maxX = std::min(x + (leftSide ? 2 : 3), width);
-        fuint32_t minY = y > 0 ? (y - 1) : 0;
-        fuint32_t maxY = std::min(y + 3, height);
+        fuint32_t craterMinX = leftSide ? (x >= size - 1 ? x - (size - 1) : 0) : x;
+        fuint32_t craterMaxX = leftSide ? (x + 1) : std::min(x + size, width);
+        fuint32_t craterMaxY = std::min(y + size, height);
 
-        fuint32_t otherX = (!leftSide ? (x + 1) : (x > 0 ? x - 1 : FUINT32_UNDEF));
+        fuint32_t minX = craterMinX > 0 ? (craterMinX - 1) : 0;
+        fuint32_t maxX = std::min(craterMaxX + 1, width);
+        fuint32_t minY = y > 0 ? (y - 1) : 0;
+        fuint32_t maxY = std::min(craterMaxY + 1, height);
 
         for (fuint32_t itX = minX; itX < maxX; ++itX)
         {
           for (fuint32_t itY = minY; itY < maxY; ++itY)
           {
-            bool craterY = (itY == y || itY == y + 1);
-            bool isInCrater = craterY && (itX == x || itX == otherX);
+            bool isInCrater = (itX >= craterMinX && itX < craterMaxX)
+              && (itY >= y && itY < craterMaxY);
             func(fuint32_pair_t{itX, itY}, isInCrater);
           }
         }
@@ -51,9 +57,7 @@ namespace majorminer
 
     private:
       ChimeraGraphInfo m_graph;
-      coordinateset_t m_occupied;
-
-      std::shared_mutex m_updateLock;
+      OccupancyGrid m_occupied;
   };
 
 }
@@ -0,0 +1,98 @@
+#include <lmrp/lmrp_crater_policy.hpp>
+
+#include <cmath>
+#include <limits>
+
+#include <common/embedding_state.hpp>
+#include <common/random_gen.hpp>
+#include <lmrp/lmrp_subgraph.hpp>
+
+using namespace majorminer;
+
+namespace
+{
+  constexpr double ACCEPTANCE_SMOOTHING = 0.5;
+}
+
+
+void CraterPolicy::start(LMRPSubgraph& gen)
+{
+  m_initialSize = gen.getCraterSize();
+  m_acceptance = 0.0;
+  m_hasAcceptance = false;
+  m_changedSize = false;
+}
+
+void CraterPolicy::finish(LMRPSubgraph& gen)
+{
+  gen.setCraterSize(m_initialSize);
+}
+
+// Weighted sampling without replacement (Efraimidis-Spirakis): each center
+// gets the key log(u) / weight and the centers are sorted by descending key.
+void CraterPolicy::selectCenters(Vector<vertex_t>& centers, fuint32_t round)
+{
+  centers.clear();
+  m_keys.clear();
+  const auto& reverse = m_state.getReverseMapping();
+  for (const auto& reverseMapped : reverse)
+  {
+    if (reverse.count(reverseMapped.first) > 1) centers.push_back(reverseMapped.first);
+  }
+  std::sort(centers.begin(), centers.end());
+  centers.erase(std::unique(centers.begin(), centers.end()), centers.end());
+
+  ProbabilisticDecision<double> random{m_state.getTaskSeed(RandomStream::LMRP_CRATERS, round)};
+  for (vertex_t center : centers)
+  {
+    double uniform = std::max(random(), std::numeric_limits<double>::min());
+    m_keys.push_back(std::make_pair(std::log(uniform) / getHotspotWeight(center), center));
+  }
+  std::sort(m_keys.begin(), m_keys.end(), std::greater<std::pair<double, vertex_t>>());
+  for (size_t idx = 0; idx < m_keys.size(); ++idx) centers[idx] = m_keys[idx].second;
+}
+
+void CraterPolicy::update(LMRPSubgraph& gen, fuint32_t nbSolved,
+  fuint32_t nbApplied, double solveTimeMs)
+{
+  m_changedSize = false;
+  if (nbSolved == 0) return;
+  const auto& config = m_state.getConfig().m_lmrp;
+  double acceptance = static_cast<double>(nbApplied) / nbSolved;
+  m_acceptance = m_hasAcceptance ? ACCEPTANCE_SMOOTHING * acceptance
+    + (1.0 - ACCEPTANCE_SMOOTHING) * m_acceptance : acceptance;
+  m_hasAcceptance = true;
+  if (!config.m_adaptiveCraters) return;
+
+  fuint32_t size = gen.getCraterSize();
+  // the solve time differs between runs, so seeded runs only follow the acceptance
+  double averageTimeMs = solveTimeMs / nbSolved;
+  if (!m_state.isDeterministic() && averageTimeMs > config.m_craterTimeBudgetMs)
+  {
+    if (size > 1) gen.setCraterSize(size - 1);
+  }
+  else if (m_acceptance < config.m_lowAcceptance)
+  { // craters are too small to reroute the overlapping chains
+    if (size < m_initialSize + config.m_maxCraterGrowth) gen.setCraterSize(size + 1);
+  }
+  else if (m_acceptance > config.m_highAcceptance && size > m_initialSize)
+  {
+    gen.setCraterSize(size - 1);
+  }
+  m_changedSize = gen.getCraterSize() != size;
+}
+
+fuint32_t CraterPolicy::getOverlap(vertex_t target) const
+{
+  fuint32_t count = m_state.getReverseMapping().count(target);
+  return count > 1 ? (count - 1) : 0;
+}
+
+fuint32_t CraterPolicy::getHotspotWeight(vertex_t target) const
+{
+  fuint32_t weight = getOverlap(target);
+  m_state.iterateTargetGraphAdjacent(target, [&](vertex_t adjacent){
+    weight += getOverlap(adjacent);
+  });
+  return weight;
+}
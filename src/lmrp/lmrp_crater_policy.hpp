@@ -0,0 +1,49 @@
+#ifndef __MAJORMINER_LMRP_CRATER_POLICY_HPP_
+#define __MAJORMINER_LMRP_CRATER_POLICY_HPP_
+
+#include <majorminer_types.hpp>
+
+namespace majorminer
+{
+
+  // Decides where the LMRP repair phase places its craters and how large
+  // they are. Centers are ordered by a weighted random permutation, so that
+  // overlap hotspots are claimed first. The crater size follows the recent
+  // acceptance rate and, unless the state is deterministic, the average
+  // solve time of a crater.
+  class CraterPolicy
+  {
+    public:
+      CraterPolicy(const EmbeddingState& state)
+        : m_state(state), m_initialSize(0), m_acceptance(0.0),
+          m_hasAcceptance(false), m_changedSize(false) {}
+
+      void start(LMRPSubgraph& gen);
+      // Restores the crater size the generator had before start
+      void finish(LMRPSubgraph& gen);
+
+      void selectCenters(Vector<vertex_t>& centers, fuint32_t round);
+      // Called once all craters of a round were committed
+      void update(LMRPSubgraph& gen, fuint32_t nbSolved, fuint32_t nbApplied, double solveTimeMs);
+
+      double getAcceptance() const { return m_acceptance; }
+      // Whether the last update resized the craters
+      bool changedSize() const { return m_changedSize; }
+
+    private:
+      fuint32_t getOverlap(vertex_t target) const;
+      fuint32_t getHotspotWeight(vertex_t target) const;
+
+    private:
+      const EmbeddingState& m_state;
+      fuint32_t m_initialSize;
+      double m_acceptance; // exponential moving average over the rounds
+      bool m_hasAcceptance;
+      bool m_changedSize;
+      Vector<std::pair<double, vertex_t>> m_keys;
+  };
+
+}
+
+
+#endif
@@ -2,22 +2,29 @@
 
 #include <common/embedding_state.hpp>
 #include <common/utils.hpp>
-#include <common/debug_utils.hpp>
 
 using namespace majorminer;
 
 
 LMRPHeuristic::LMRPHeuristic(EmbeddingState& state, vertex_t target)
-  : m_state(state), m_done(false), m_numberOverlaps(0),
-    m_numberMapped(0), m_currentSource(0)
+  : m_state(state), m_done(false), m_failed(false), m_numberOverlaps(0),
+    m_numberMapped(0), m_currentStamp(0), m_currentSource(0)
 {
   LMRPSubgraph* gen = state.getSubgraphGen();
   if (gen != nullptr)
   {
+    // the caller has to commit the crater once done
     bool success = gen->getSubgraph(target, m_crater);
-    // std::cout << "Success in subgraph " << success << std::endl;
-    // TODO: commit once done!
     if (!success) m_done = true;
+    else if (state.getDefectMask() != nullptr)
+    { // inactive target vertices cannot be used for the repair
+      Vector<vertex_t> inactive{};
+      for (vertex_t craterVertex : m_crater)
+      {
+        if (!state.isTargetVertexActive(craterVertex)) inactive.push_back(craterVertex);
+      }
+      for (vertex_t craterVertex : inactive) m_crater.unsafe_erase(craterVertex);
+    }
   }
   else m_done = true;
 }
@@ -28,15 +35,28 @@ void LMRPHeuristic::optimize()
   if (m_done) return;
   calculatePreviousFitness();
   buildBorder();
-  printNodeset(m_crater);
-  printNodeset(m_border);
   identifyEdges();
   identifyComponents();
   identifyDestroyed();
-  printAdjacencyList(m_sourceAdjacencies);
 
   initializeDijkstraData();
   solve();
+  m_done = true;
+}
+
+bool LMRPHeuristic::improved() const
+{
+  if (m_failed || m_crater.empty()) return false;
+  fuint32_t numberOverlaps = 0;
+  fuint32_t numberMapped = 0;
+  for (vertex_t target : m_crater)
+  {
+    fuint32_t count = m_reverse.count(target);
+    if (count > 0) numberMapped++;
+    if (count > 1) numberOverlaps += (count - 1);
+  }
+  return numberOverlaps < m_numberOverlaps
+    || (numberOverlaps == m_numberOverlaps && numberMapped < m_numberMapped);
 }
 
 void LMRPHeuristic::buildBorder()
@@ -55,10 +75,30 @@ void LMRPHeuristic::identifyEdges()
 {
   identifyEdgesFrom(m_crater);
   identifyEdgesFrom(m_border);
+  identifyOverlapEdges();
 
   convertToAdjacencyList(m_sourceAdjacencies, m_edges);
 }
 
+// edges embedded by two source vertices sharing a crater vertex
+void LMRPHeuristic::identifyOverlapEdges()
+{
+  const auto& sourceGraph = *m_state.getSourceGraph();
+  const auto& reverse = m_state.getReverseMapping();
+  for (vertex_t target : m_crater)
+  {
+    auto range = reverse.equal_range(target);
+    for (auto revA = range.first; revA != range.second; ++revA)
+    {
+      for (auto revB = std::next(revA); revB != range.second; ++revB)
+      {
+        edge_t edge{revA->second, revB->second};
+        if (containsEdge(sourceGraph, edge)) m_edges.insert(orderedPair(edge));
+      }
+    }
+  }
+}
+
 void LMRPHeuristic::identifyEdgesFrom(const nodeset_t& from)
 {
   const auto& sourceGraph = *m_state.getSourceGraph();
@@ -69,7 +109,7 @@ void LMRPHeuristic::identifyEdgesFrom(const nodeset_t& from)
     for (auto itB = m_crater.begin(); itB != m_crater.end(); ++itB)
     {
       if (*itB == *itA) continue;
-      else if (containsEdge(targetGraph, edge_t{*itA, *itB}))
+      else if (containsEdge(targetGraph, edge_t{*itA, *itB}) && m_state.isTargetEdgeActive(*itA, *itB))
       {
         auto rangeA = reverse.equal_range(*itA);
         for (auto revA = rangeA.first; revA != rangeA.second; ++revA)
@@ -116,10 +156,11 @@ void LMRPHeuristic::identifyComponents()
       if (empty_range(dfsStack.top())) dfsStack.pop();
       else
       {
+        vertex_t current = dfsStack.top().first->first;
         vertex_t neighbor = dfsStack.top().first->second;
         dfsStack.top().first++;
         edge_t mapped{neighbor, source};
-        if (!subgraph.contains(mapped)) continue;
+        if (!subgraph.contains(mapped) || !m_state.isTargetEdgeActive(current, neighbor)) continue;
         dfsStack.push(targetGraph.equal_range(neighbor));
         if (borderMapped.contains(mapped)) currentReachable.push(neighbor);
         subgraph.unsafe_erase(mapped);
@@ -147,6 +188,7 @@ void LMRPHeuristic::buildSubgraphs(graph_t& borderMapped, graph_t& subgraph)
     for (auto it = range.first; it != range.second; ++it)
     {
       borderMapped.insert(*it);
+      m_borderSources.insert(it->second);
     }
   }
   subgraph.insert(borderMapped.begin(), borderMapped.end());
@@ -197,6 +239,7 @@ void LMRPHeuristic::solve()
     {
       connectComponent(component, idx);
     }
+    if (m_failed) return;
     idx++;
   }
 
@@ -204,6 +247,7 @@ void LMRPHeuristic::solve()
   for (auto& component : m_componentsList)
   {
     if (!component.wasSatisfied()) connectComponent(component, idx);
+    if (m_failed) return;
     idx++;
   }
 
@@ -212,16 +256,44 @@ void LMRPHeuristic::solve()
 
 void LMRPHeuristic::initializeDijkstraData()
 {
-  for (vertex_t target : m_crater)
+  m_localVertices.reserve(m_crater.size() + m_border.size());
+  for (vertex_t target : m_crater) m_localVertices.push_back(target);
+  for (vertex_t target : m_border) m_localVertices.push_back(target);
+  for (fuint32_t local = 0; local < m_localVertices.size(); ++local)
   {
-    m_bestPaths[target] = DijkstraVertex{target};
+    m_localIndex.insert(std::make_pair(m_localVertices[local], local));
   }
+
+  m_localAdjOffsets.reserve(m_localVertices.size() + 1);
+  m_localAdjOffsets.push_back(0);
+  for (vertex_t target : m_localVertices)
+  {
+    m_state.iterateTargetGraphAdjacent(target, [&](vertex_t adjacent){
+      if (m_crater.contains(adjacent)) m_localAdj.push_back(m_localIndex[adjacent]);
+    });
+    m_localAdjOffsets.push_back(m_localAdj.size());
+  }
+
+  m_bestPaths.reserve(m_localVertices.size());
+  for (vertex_t target : m_localVertices) m_bestPaths.emplace_back(target);
+  m_pathStamps.assign(m_localVertices.size(), m_currentStamp);
 }
 
 void LMRPHeuristic::resetDijkstra()
 {
-  for (auto& vertex : m_bestPaths) vertex.second.reset();
-  while(!m_dijkstraQueue.empty()) m_dijkstraQueue.pop();
+  m_currentStamp++;
+  m_dijkstraQueue.clear();
+}
+
+DijkstraVertex& LMRPHeuristic::getPath(fuint32_t local)
+{
+  auto& vertex = m_bestPaths[local];
+  if (m_pathStamps[local] != m_currentStamp)
+  {
+    vertex.reset();
+    m_pathStamps[local] = m_currentStamp;
+  }
+  return vertex;
 }
 
 void LMRPHeuristic::connectComponent(ConnectedList& component, fuint32_t componentIdx)
@@ -237,12 +309,12 @@ void LMRPHeuristic::connectComponent(ConnectedList& component, fuint32_t compone
     {
       toConnect.insert(m_componentVertices[component.m_idx + offset]);
     }
-    while(!toConnect.empty())
+    while(!toConnect.empty() && !m_failed)
     {
       runDijkstraToTarget(toConnect, root);
     }
   }
-  if (componentIdx == m_componentsList.size() ||
+  if (componentIdx + 1 == m_componentsList.size() ||
     m_componentsList[componentIdx + 1].m_source != component.m_source)
   {
     // embedd all edges
@@ -250,7 +322,10 @@ void LMRPHeuristic::connectComponent(ConnectedList& component, fuint32_t compone
     auto adjRange = m_sourceAdjacencies.equal_range(m_currentSource);
     for (auto adjIt = adjRange.first; adjIt != adjRange.second; ++adjIt)
     {
-      if (m_mapping.contains(adjIt->second)) toConnect.insert(adjIt->second);
+      if (m_mapping.contains(adjIt->second) || m_borderSources.contains(adjIt->second))
+      {
+        toConnect.insert(adjIt->second);
+      }
     }
 
     auto mappedRange = m_mapping.equal_range(m_currentSource);
@@ -258,8 +333,13 @@ void LMRPHeuristic::connectComponent(ConnectedList& component, fuint32_t compone
     { // check for every within crater whether already connected to adjacent
       checkConnectedToSource(toConnect, mapped->second);
     }
+    auto originalRange = m_state.getMapping().equal_range(m_currentSource);
+    for (auto mapped = originalRange.first; mapped != originalRange.second; ++mapped)
+    { // the border part of the super vertex might already be adjacent
+      if (m_border.contains(mapped->second)) checkConnectedToSource(toConnect, mapped->second);
+    }
 
-    while(!toConnect.empty())
+    while(!toConnect.empty() && !m_failed)
     {
       connectAdjacentComponents(toConnect);
     }
@@ -292,9 +372,10 @@ fuint32_pair_t LMRPHeuristic::getLeastMappedNeighbor(vertex_t source)
   for (auto mappedIt = range.first; mappedIt != range.second; ++mappedIt)
   {
     fuint32_t count = m_mapping.count(mappedIt->second);
-    if (count > 0 && count < connectivity)
+    if (count == 0) continue;
+    numberMappedNeighbors++;
+    if (count < connectivity)
     {
-      numberMappedNeighbors++;
       connectivity = count;
       neighbor = mappedIt->second;
     }
@@ -309,6 +390,7 @@ void LMRPHeuristic::embeddDestroyed()
   for (vertex_t destroyed : m_completelyDestroyed)
   {
     embeddSingleDestroyed(destroyed);
+    if (m_failed) return;
   }
 }
 
@@ -328,7 +410,7 @@ void LMRPHeuristic::mapToFreeVertex()
     }
   }
   if (isDefined(count)) mapVertex(m_currentSource, bestFound);
-  else throw std::runtime_error("Error in LMRP heuristic!");
+  else m_failed = true;
 }
 
 void LMRPHeuristic::mapToSingleAdjacent(vertex_t neighbor)
@@ -354,7 +436,7 @@ void LMRPHeuristic::mapToSingleAdjacent(vertex_t neighbor)
     if (count == 0) break;
   }
   if (isDefined(count)) mapVertex(m_currentSource, bestFound);
-  else throw std::runtime_error("Error in LMRP heuristic!");
+  else m_failed = true;
 }
 
 void LMRPHeuristic::embeddSingleDestroyed(vertex_t source)
@@ -394,20 +476,23 @@ void LMRPHeuristic::dijkstraDestroyed(vertex_t source, vertex_t neighbor)
   adjacentMapped.unsafe_erase(neighbor);
   while(!adjacentMapped.empty())
   {
-    DijkstraVertex next{};
-    while(!m_dijkstraQueue.empty())
+    fuint32_t next, overlaps, length;
+    bool connected = false;
+    while(m_dijkstraQueue.pop(next, overlaps, length))
     {
-      next = m_dijkstraQueue.top();
-      m_dijkstraQueue.pop();
-      if (m_bestPaths[next.m_target].visited()) continue;
-      bool connected = checkConnectedToSource(adjacentMapped, next.m_target);
+      if (getPath(next).visited()) continue;
+      connected = checkConnectedToSource(adjacentMapped, m_localVertices[next]);
       if (connected)
       {
-        addEmbeddedPath(next.m_target);
+        addEmbeddedPath(next);
         break;
       }
-      addSingleVertexNeighbors(next.m_target,
-        next.m_overlapCnt, next.m_nonOverlapCnt);
+      addSingleVertexNeighbors(next, overlaps, length);
+    }
+    if (!connected)
+    { // remaining neighbors are not reachable through the crater
+      m_failed = true;
+      return;
     }
     if (!adjacentMapped.empty())
     {
@@ -417,123 +502,104 @@ void LMRPHeuristic::dijkstraDestroyed(vertex_t source, vertex_t neighbor)
   }
 }
 
-void LMRPHeuristic::addSingleVertexNeighbors(vertex_t target,
+void LMRPHeuristic::addSingleVertexNeighbors(fuint32_t local,
   fuint32_t overlaps, fuint32_t length)
 {
-  const auto& targetGraph = m_state.getTargetAdjGraph();
-  auto range = targetGraph.equal_range(target);
-  for (auto it = range.first; it != range.second; ++it)
+  for (fuint32_t idx = m_localAdjOffsets[local]; idx < m_localAdjOffsets[local + 1]; ++idx)
   {
-    // std::cout << "Targetgraph (" << it->first << "," << it->second << ")" << std::endl;
-    if (!m_crater.contains(it->second)) continue;
-    if (m_bestPaths[it->second].wasVisited()) continue;
-    auto& neighbor = m_bestPaths[it->second];
-    if (neighbor.m_overlapCnt < overlaps) continue;
+    fuint32_t adjacent = m_localAdj[idx];
+    auto& neighbor = getPath(adjacent);
+    if (neighbor.wasVisited() || neighbor.m_overlapCnt < overlaps) continue;
     bool contained = m_superVertices.contains(edge_t{m_currentSource, neighbor.m_target});
-    bool count = m_reverse.count(neighbor.m_target);
-    bool overlap = !contained && count > 0;
-    bool lowered = neighbor.lowerTo(target,
-      overlaps + (overlap ? 1 : 0),
-      length + (contained ? 0 : 1));
-    // std::cout << "Adding vertex " << neighbor.m_target  << " from " << target << std::endl;
-    if (lowered) m_dijkstraQueue.push(neighbor);
+    bool overlap = !contained && m_reverse.contains(neighbor.m_target);
+    fuint32_t nextOverlaps = overlaps + (overlap ? 1 : 0);
+    fuint32_t nextLength = length + (contained ? 0 : 1);
+    if (neighbor.lowerTo(local, nextOverlaps, nextLength))
+    {
+      m_dijkstraQueue.push(adjacent, nextOverlaps, nextLength);
+    }
   }
 }
 
 void LMRPHeuristic::runDijkstraToTarget(nodeset_t& targets, vertex_t root)
 {
   resetDijkstra();
-  // std::cout << "Running Dijkstra from root " << root << " to targets: "<< std::endl;
-  printNodeset(targets);
   vertex_t connectedTo = checkConnectedTo(targets, root);
   if (!isDefined(connectedTo))
   {
-    vertex_t best = FUINT32_UNDEF;
-    addSingleVertexNeighbors(root, 0, 0);
-    DijkstraVertex next{};
-    while(!m_dijkstraQueue.empty())
+    fuint32_t best = FUINT32_UNDEF;
+    fuint32_t rootLocal = m_localIndex[root];
+    getPath(rootLocal).visited();
+    addSingleVertexNeighbors(rootLocal, 0, 0);
+    fuint32_t next, overlaps, length;
+    while(m_dijkstraQueue.pop(next, overlaps, length))
     {
-      next = m_dijkstraQueue.top();
-      m_dijkstraQueue.pop();
-      if (m_bestPaths[next.m_target].visited()) continue;
-      connectedTo = checkConnectedTo(targets, next.m_target);
+      if (getPath(next).visited()) continue;
+      connectedTo = checkConnectedTo(targets, m_localVertices[next]);
       if (isDefined(connectedTo))
       {
-        best = next.m_target;
+        best = next;
         break;
       }
-      addSingleVertexNeighbors(next.m_target,
-        next.m_overlapCnt, next.m_nonOverlapCnt);
+      addSingleVertexNeighbors(next, overlaps, length);
     }
     if (isDefined(best)) addEmbeddedPath(best);
   }
-  if (isDefined(connectedTo))
-  {
-    std::cout << "Removing vertex " << connectedTo << std::endl;
-    targets.unsafe_erase(connectedTo);
-  }
-  else throw std::runtime_error("No connection found!");
+  if (isDefined(connectedTo)) targets.unsafe_erase(connectedTo);
+  else m_failed = true;
 }
 
-void LMRPHeuristic::addEmbeddedPath(vertex_t leaf)
+void LMRPHeuristic::addEmbeddedPath(fuint32_t leaf)
 {
-  // std::cout << "Adding the Embedding path" << std::endl;
-  auto* vertex = &m_bestPaths[leaf];
-  while(vertex != nullptr)
+  for (fuint32_t local = leaf; isDefined(local); local = getPath(local).m_parent)
   {
-    std::cout << vertex->m_target << " ";
-    mapVertex(m_currentSource, vertex->m_target);
-    if (isDefined(vertex->m_parent) && m_bestPaths.contains(vertex->m_parent))
-    {
-      vertex = &m_bestPaths[vertex->m_parent];
-    }
-    else vertex = nullptr;
+    mapVertex(m_currentSource, m_localVertices[local]);
   }
-  std::cout << std::endl;
 }
 
 vertex_t LMRPHeuristic::checkConnectedTo(const nodeset_t& wantedTargets,
   vertex_t target)
 {
-  const auto& targetGraph = m_state.getTargetAdjGraph();
-  auto adjRange = targetGraph.equal_range(target);
-  for (auto adjIt = adjRange.first; adjIt != adjRange.second; ++adjIt)
-  {
-    if (wantedTargets.contains(adjIt->second)) return adjIt->second;
-  }
-
-  return FUINT32_UNDEF;
+  vertex_t connectedTo = FUINT32_UNDEF;
+  m_state.iterateTargetGraphAdjacentBreak(target, [&](vertex_t adjacent){
+    if (wantedTargets.contains(adjacent)) connectedTo = adjacent;
+    return isDefined(connectedTo);
+  });
+  return connectedTo;
 }
 
 
 void LMRPHeuristic::addAllMapped(vertex_t source)
 {
-  const auto& targetGraph = m_state.getTargetAdjGraph();
-  nodeset_t closure{};
   auto range = m_mapping.equal_range(source);
   for (auto it = range.first; it != range.second; ++it)
   {
-    auto adjRange = targetGraph.equal_range(it->second);
-    for (auto adjIt = adjRange.first; adjIt != adjRange.second; ++adjIt)
+    auto localIt = m_localIndex.find(it->second);
+    if (localIt == m_localIndex.end()) continue;
+    fuint32_t local = localIt->second;
+    for (fuint32_t idx = m_localAdjOffsets[local]; idx < m_localAdjOffsets[local + 1]; ++idx)
     {
-      if (m_crater.contains(adjIt->second)) closure.insert(adjIt->second);
+      vertex_t adjacent = m_localVertices[m_localAdj[idx]];
+      if (m_superVertices.contains(edge_t{source, adjacent})) continue;
+      pushSeed(adjacent, m_reverse.contains(adjacent) ? 1 : 0, 1);
     }
   }
   const auto& originalMapping = m_state.getMapping();
   auto originalMapped = originalMapping.equal_range(source);
   for (auto it = originalMapped.first; it != originalMapped.second; ++it)
-  {
-    if (m_border.contains(it->second)) closure.insert(it->second);
-  }
-  for (auto it = range.first; it != range.second; ++it)
-  {
-    closure.unsafe_erase(it->second);
+  { // border vertices of the source are already part of its super vertex
+    if (!m_border.contains(it->second)) continue;
+    if (m_superVertices.contains(edge_t{source, it->second})) continue;
+    pushSeed(it->second, 0, 0);
   }
+}
 
-  for (vertex_t adj : closure)
+void LMRPHeuristic::pushSeed(vertex_t target, fuint32_t overlaps, fuint32_t length)
+{
+  fuint32_t local = m_localIndex[target];
+  if (getPath(local).lowerTo(FUINT32_UNDEF, overlaps, length))
   {
-    m_bestPaths[adj] = DijkstraVertex{adj};
-    m_dijkstraQueue.push(m_bestPaths[adj]);
+    m_dijkstraQueue.push(local, overlaps, length);
   }
 }
 
@@ -541,40 +607,35 @@ void LMRPHeuristic::connectAdjacentComponents(nodeset_t& adjacent)
 {
   resetDijkstra();
   addAllMapped(m_currentSource);
-  DijkstraVertex next{};
-  while(!m_dijkstraQueue.empty())
+  fuint32_t next, overlaps, length;
+  while(m_dijkstraQueue.pop(next, overlaps, length))
   {
-    next = m_dijkstraQueue.top();
-    m_dijkstraQueue.pop();
-    if (m_bestPaths[next.m_target].visited()) continue;
-    bool connected = checkConnectedToSource(adjacent, next.m_target);
+    if (getPath(next).visited()) continue;
+    bool connected = checkConnectedToSource(adjacent, m_localVertices[next]);
     if (connected)
     {
-      addEmbeddedPath(next.m_target);
-      break;
+      addEmbeddedPath(next);
+      return;
     }
-    addSingleVertexNeighbors(next.m_target,
-      next.m_overlapCnt, next.m_nonOverlapCnt);
+    addSingleVertexNeighbors(next, overlaps, length);
   }
+  m_failed = true;
 }
 
 bool LMRPHeuristic::checkConnectedToSource(nodeset_t& wantedSources, vertex_t target)
 {
-  const auto& targetGraph = m_state.getTargetAdjGraph();
   const auto& originalReverse = m_state.getReverseMapping();
-  auto adjRange = targetGraph.equal_range(target);
   bool removed = false;
-  for (auto adjIt = adjRange.first; adjIt != adjRange.second; ++adjIt)
-  {
-    auto revRange = (m_crater.contains(adjIt->second) ?
-      m_reverse.equal_range(adjIt->second) :
-      originalReverse.equal_range(adjIt->second));
+  m_state.iterateTargetGraphAdjacent(target, [&](vertex_t adjacent){
+    auto revRange = (m_crater.contains(adjacent) ?
+      m_reverse.equal_range(adjacent) :
+      originalReverse.equal_range(adjacent));
     for (auto revIt = revRange.first; revIt != revRange.second; ++revIt)
     {
       auto extracted = wantedSources.unsafe_extract(revIt->second);
       removed |= !extracted.empty();
     }
-  }
+  });
 
   return removed;
 }
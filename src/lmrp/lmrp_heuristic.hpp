@@ -12,12 +12,18 @@ namespace majorminer
     public:
       LMRPHeuristic(EmbeddingState& state, vertex_t target);
       void optimize();
+      // Whether the repaired crater has less overlap than before
+      bool improved() const;
+      bool hasCrater() const { return !m_crater.empty(); }
+      bool failed() const { return m_failed; }
+      const nodeset_t& getCrater() const { return m_crater; }
       const embedding_mapping_t getMapping() const { return m_mapping; }
 
     private:
       void buildBorder();
       void identifyEdges();
       void identifyEdgesFrom(const nodeset_t& from);
+      void identifyOverlapEdges();
       void identifyComponents();
       void buildSubgraphs(graph_t& borderMapped, graph_t& subgraph);
       void calculatePreviousFitness();
@@ -31,10 +37,12 @@ namespace majorminer
       void addReachableComponent(vertex_t target, vertex_t source);
       void initializeDijkstraData();
       void resetDijkstra();
-      void addSingleVertexNeighbors(vertex_t target, fuint32_t overlaps, fuint32_t length);
+      DijkstraVertex& getPath(fuint32_t local);
+      void pushSeed(vertex_t target, fuint32_t overlaps, fuint32_t length);
+      void addSingleVertexNeighbors(fuint32_t local, fuint32_t overlaps, fuint32_t length);
       void runDijkstraToTarget(nodeset_t& targets, vertex_t root);
       vertex_t checkConnectedTo(const nodeset_t& wantedTargets, vertex_t target);
-      void addEmbeddedPath(vertex_t leaf);
+      void addEmbeddedPath(fuint32_t leaf);
       void connectAdjacentComponents(nodeset_t& adjacent);
       bool checkConnectedToSource(nodeset_t& wantedSources, vertex_t target);
       void addAllMapped(vertex_t source);
@@ -50,11 +58,13 @@ namespace majorminer
     private:
       const EmbeddingState& m_state;
       bool m_done;
+      bool m_failed;
       fuint32_t m_numberOverlaps;
       fuint32_t m_numberMapped;
 
       nodeset_t m_crater;
       nodeset_t m_border;
+      nodeset_t m_borderSources;
       nodeset_t m_completelyDestroyed;
       graph_t m_edges;
       adjacency_list_t m_sourceAdjacencies;
@@ -66,8 +76,18 @@ namespace majorminer
       embedding_mapping_t m_reverse;
       graph_t m_superVertices;
 
-      PriorityQueue<DijkstraVertex> m_dijkstraQueue;
-      UnorderedMap<vertex_t, DijkstraVertex> m_bestPaths;
+      // Dense local index of the crater followed by its border. The CSR
+      // adjacency only lists crater neighbors as paths never leave the crater.
+      UnorderedMap<vertex_t, fuint32_t> m_localIndex;
+      Vector<vertex_t> m_localVertices;
+      Vector<fuint32_t> m_localAdjOffsets;
+      Vector<fuint32_t> m_localAdj;
+
+      // entries of m_bestPaths are only valid if their stamp is the current one
+      DijkstraBucketQueue m_dijkstraQueue;
+      Vector<DijkstraVertex> m_bestPaths;
+      Vector<fuint32_t> m_pathStamps;
+      fuint32_t m_currentStamp;
       vertex_t m_currentSource;
   };
 
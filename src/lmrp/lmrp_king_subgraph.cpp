@@ -7,63 +7,30 @@ bool KingLMRPSubgraph::getSubgraph(vertex_t contained, nodeset_t& subgraph)
 {
   fuint32_t x = m_graph.getXCoord(contained);
   fuint32_t y = m_graph.getYCoord(contained);
-  m_updateLock.lock();
-  bool success = !checkOccupation(x, y);
-  if (success)
-  {
-    neighborhood(x,y,
-      [&](const fuint32_pair_t& pair, bool inCrater){
-        if (inCrater) m_occupied.insert(pair);
-    });
-  }
-  m_updateLock.unlock();
-  if (success)
-  {
-    subgraph.clear();
-    fuint32_t width = m_graph.getWidth();
-    neighborhood(x,y,
-      [&](const fuint32_pair_t& pair, bool inCrater){
-        if (inCrater) // pair := (x_coord, y_coord)
-        {
-          subgraph.insert(pair.first * width + pair.second);
-        }
-    });
-  }
-  return success;
+  auto cells = [&](auto func){ neighborhood(x, y, func); };
+  if (!m_occupied.reserve(cells)) return false;
+
+  subgraph.clear();
+  fuint32_t width = m_graph.getWidth();
+  cells([&](const fuint32_pair_t& pair, bool inCrater){
+    if (inCrater) // pair := (x_coord, y_coord)
+    {
+      subgraph.insert(pair.second * width + pair.first);
+    }
+  });
+  return true;
 }
 
 bool KingLMRPSubgraph::isBeingDestroyed(vertex_t contained)
 {
   fuint32_t x = m_graph.getXCoord(contained);
   fuint32_t y = m_graph.getYCoord(contained);
-
-  m_updateLock.lock_shared();
-  bool occupied = checkOccupation(x, y);
-  m_updateLock.unlock_shared();
-
-  return occupied;
-}
-
-bool KingLMRPSubgraph::checkOccupation(fuint32_t x, fuint32_t y) const
-{
-  bool occupied = false;
-  neighborhood(x,y,
-    [&](const fuint32_pair_t& pair, bool){
-      occupied |= m_occupied.contains(pair);
-  });
-  return occupied;
+  return m_occupied.anyOccupied([&](auto func){ neighborhood(x, y, func); });
 }
 
 void KingLMRPSubgraph::commit(vertex_t contained)
 {
   fuint32_t x = m_graph.getXCoord(contained);
   fuint32_t y = m_graph.getYCoord(contained);
-  m_updateLock.lock();
-  neighborhood(x,y,
-    [&](const fuint32_pair_t& pair, bool inCrater){
-      if (inCrater) m_occupied.unsafe_erase(pair);
-    });
-  m_updateLock.unlock();
+  m_occupied.free([&](auto func){ neighborhood(x, y, func); });
 }
-
-
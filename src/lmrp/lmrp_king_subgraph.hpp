@@ -4,13 +4,15 @@
 #include <majorminer_types.hpp>
 #include <common/graph_info.hpp>
 #include <lmrp/lmrp_subgraph.hpp>
+#include <lmrp/lmrp_occupancy.hpp>
 
 namespace majorminer
 {
   class KingLMRPSubgraph : public LMRPSubgraph
   {
     public:
-      KingLMRPSubgraph(KingGraphInfo& g): m_graph(g) {}
+      KingLMRPSubgraph(KingGraphInfo& g)
+        : LMRPSubgraph(2), m_graph(g), m_occupied(g.getWidth(), g.getHeight()) {}
       ~KingLMRPSubgraph() {}
 
       bool getSubgraph(vertex_t contained, nodeset_t& subgraph) override;
@@ -20,22 +22,23 @@ namespace majorminer
       void commit(vertex_t contained) override;
 
     private:
-      bool checkOccupation(fuint32_t x, fuint32_t y) const;
 
+      // The crater contains all vertices within m_craterSize steps
       template<typename Functor>
       void neighborhood(fuint32_t x, fuint32_t y, Functor func) const
       {
-        fuint32_t minX = static_cast<fuint32_t>(std::max(static_cast<int>(x) - 3, 0));
-        fuint32_t maxX = std::min(x + 4, m_graph.getWidth());
-        fuint32_t minY = static_cast<fuint32_t>(std::max(static_cast<int>(y) - 3, 0));
-        fuint32_t maxY = std::min(y + 4, m_graph.getHeight());
+        fuint32_t radius = m_craterSize;
+        fuint32_t minX = x > radius ? (x - radius - 1) : 0;
+        fuint32_t maxX = std::min(x + radius + 2, m_graph.getWidth());
+        fuint32_t minY = y > radius ? (y - radius - 1) : 0;
+        fuint32_t maxY = std::min(y + radius + 2, m_graph.getHeight());
 
         for (fuint32_t itX = minX; itX < maxX; ++itX)
         {
-          bool craterX = ((itX + 3) != x) && (itX - 3 != x);
+          bool craterX = (itX + radius >= x) && (itX <= x + radius);
           for (fuint32_t itY = minY; itY < maxY; ++itY)
           {
-            bool isInCrater = craterX && ((itY + 3) != y) && (itY - 3 != y);
+            bool isInCrater = craterX && (itY + radius >= y) && (itY <= y + radius);
             func(fuint32_pair_t{itX, itY}, isInCrater);
           }
         }
@@ -43,9 +46,7 @@ namespace majorminer
 
     private:
       KingGraphInfo m_graph;
-      coordinateset_t m_occupied;
-
-      std::shared_mutex m_updateLock;
+      OccupancyGrid m_occupied;
   };
 
 }
@@ -0,0 +1,206 @@
+#include "lmrp/lmrp_manager.hpp"
+
+#include <sstream>
+#include <chrono>
+
+#include <common/embedding_state.hpp>
+#include <common/embedding_manager.hpp>
+#include <common/embedding_visualizer.hpp>
+#include <common/utils.hpp>
+#include <lmrp/lmrp_subgraph.hpp>
+
+using namespace majorminer;
+
+
+void LMRPManager::operator()()
+{
+  m_nbRepairs = 0;
+  LMRPSubgraph* gen = m_state.getSubgraphGen();
+  if (gen == nullptr) return;
+
+  Vector<vertex_t> centers{};
+  [[maybe_unused]] auto& profiler = m_state.getProfiler();
+  fuint32_t rounds = m_state.getConfig().m_lmrp.m_rounds;
+  m_policy.start(*gen);
+  for (fuint32_t round = 0; round < rounds; ++round)
+  {
+    m_policy.selectCenters(centers, round);
+    if (centers.empty()) break;
+
+    {
+      PROFILE_SCOPE(profiler, "claim craters")
+      claimCraters(*gen, centers);
+    }
+    if (m_heuristics.empty()) break;
+
+    // craters are disjoint and the state is not changed while solving
+    std::atomic<int64_t> solveTimeUs{0};
+    PROFILE_CONTEXT(profiler, context)
+    tbb::parallel_for( tbb::blocked_range<size_t>(0, m_heuristics.size(), 1),
+      [&](const tbb::blocked_range<size_t>& range) {
+        for (auto idx = range.begin(); idx != range.end(); ++idx)
+        {
+          PROFILE_SCOPE(profiler, "solve crater", context)
+          auto start = std::chrono::steady_clock::now();
+          m_heuristics[idx]->optimize();
+          auto elapsed = std::chrono::steady_clock::now() - start;
+          solveTimeUs += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        }
+    });
+
+    fuint32_t nbApplied = 0;
+    {
+      PROFILE_SCOPE(profiler, "apply repairs")
+      for (size_t idx = 0; idx < m_heuristics.size(); ++idx)
+      {
+        if (m_heuristics[idx]->improved() && applyRepair(*m_heuristics[idx])) nbApplied++;
+        gen->commit(m_claimed[idx]);
+      }
+    }
+    m_nbRepairs += nbApplied;
+    m_embeddingManager.synchronize();
+    m_policy.update(*gen, m_heuristics.size(), nbApplied, solveTimeUs.load() / 1000.0);
+    m_heuristics.clear();
+    m_claimed.clear();
+    if (nbApplied == 0 && !m_policy.changedSize()) break;
+    if (m_state.getValidityTracker().isValid()) break;
+  }
+  m_policy.finish(*gen);
+}
+
+void LMRPManager::claimCraters(LMRPSubgraph& gen, const Vector<vertex_t>& centers)
+{
+  for (vertex_t center : centers)
+  {
+    if (gen.isBeingDestroyed(center)) continue;
+    auto heuristic = std::make_unique<LMRPHeuristic>(m_state, center);
+    if (!heuristic->hasCrater()) continue;
+    m_heuristics.push_back(std::move(heuristic));
+    m_claimed.push_back(center);
+  }
+}
+
+// Replaces the crater part of every affected super vertex by the repaired one.
+// Other craters might have been applied in between, so the repair is
+// validated against the current mapping first.
+bool LMRPManager::applyRepair(const LMRPHeuristic& heuristic)
+{
+  const auto& crater = heuristic.getCrater();
+  const auto repaired = heuristic.getMapping();
+  const auto& mapping = m_embeddingManager.getMapping();
+  const auto& reverse = m_embeddingManager.getReverseMapping();
+
+  UnorderedMap<vertex_t, nodeset_t> superVertices{};
+  for (vertex_t target : crater)
+  {
+    auto range = reverse.equal_range(target);
+    for (auto it = range.first; it != range.second; ++it) superVertices[it->second];
+  }
+  for (const auto& mapped : repaired)
+  {
+    if (crater.contains(mapped.second)) superVertices[mapped.first].insert(mapped.second);
+  }
+  for (auto& superVertex : superVertices)
+  {
+    auto range = mapping.equal_range(superVertex.first);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (!crater.contains(it->second)) superVertex.second.insert(it->second);
+    }
+  }
+  if (!isValidRepair(crater, superVertices)) return false;
+
+  Vector<fuint32_pair_t> deleted{};
+  Vector<fuint32_pair_t> inserted{};
+  for (const auto& superVertex : superVertices)
+  {
+    vertex_t source = superVertex.first;
+    auto range = mapping.equal_range(source);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (!superVertex.second.contains(it->second)) deleted.push_back(*it);
+    }
+    for (vertex_t target : superVertex.second)
+    {
+      if (!containsPair(mapping, source, target)) inserted.push_back(std::make_pair(source, target));
+    }
+  }
+
+  for (const auto& mapped : deleted) m_embeddingManager.deleteMappingPair(mapped.first, mapped.second);
+  for (const auto& mapped : inserted)
+  {
+    m_embeddingManager.insertMappingPair(mapped.first, mapped.second);
+    m_embeddingManager.occupyNode(mapped.second);
+  }
+  for (const auto& mapped : deleted)
+  {
+    if (!reverse.contains(mapped.second)) m_embeddingManager.freeNode(mapped.second);
+  }
+  m_embeddingManager.commit();
+
+  if (m_state.hasVisualizer())
+  {
+    std::stringstream ss;
+    ss << "LMRP repaired a crater of " << crater.size() << " vertices." << std::endl;
+    m_embeddingManager.getVisualizer()->draw(m_embeddingManager.getMapping(), ss.str().c_str());
+  }
+  return true;
+}
+
+bool LMRPManager::isValidRepair(const nodeset_t& crater,
+  const UnorderedMap<vertex_t, nodeset_t>& superVertices) const
+{
+  const auto& reverse = m_embeddingManager.getReverseMapping();
+  auto isMappedTo = [&](vertex_t target, vertex_t source){
+    auto findIt = superVertices.find(source);
+    if (findIt != superVertices.end()) return findIt->second.contains(target);
+    return !crater.contains(target) && containsPair(reverse, target, source);
+  };
+
+  for (const auto& superVertex : superVertices)
+  {
+    if (superVertex.second.empty() || !isConnected(superVertex.second)) return false;
+
+    bool embedded = true;
+    m_state.iterateSourceGraphAdjacentBreak(superVertex.first, [&](vertex_t adjacentSource){
+      bool found = false;
+      for (vertex_t target : superVertex.second)
+      {
+        found = isMappedTo(target, adjacentSource);
+        if (!found)
+        {
+          m_state.iterateTargetGraphAdjacentBreak(target, [&](vertex_t adjacentTarget){
+            found = isMappedTo(adjacentTarget, adjacentSource);
+            return found;
+          });
+        }
+        if (found) break;
+      }
+      embedded = found;
+      return !embedded;
+    });
+    if (!embedded) return false;
+  }
+  return true;
+}
+
+bool LMRPManager::isConnected(const nodeset_t& superVertex) const
+{
+  nodeset_t visited{};
+  Stack<vertex_t> dfsStack{};
+  dfsStack.push(*superVertex.begin());
+  visited.insert(*superVertex.begin());
+  while(!dfsStack.empty())
+  {
+    vertex_t current = dfsStack.top();
+    dfsStack.pop();
+    m_state.iterateTargetGraphAdjacent(current, [&](vertex_t adjacent){
+      if (superVertex.contains(adjacent) && !visited.contains(adjacent))
+      {
+        visited.insert(adjacent);
+        dfsStack.push(adjacent);
+      }
+    });
+  }
+  return visited.size() == superVertex.size();
+}
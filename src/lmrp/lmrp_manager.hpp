@@ -0,0 +1,47 @@
+#ifndef __MAJORMINER_LMRP_MANAGER_HPP_
+#define __MAJORMINER_LMRP_MANAGER_HPP_
+
+#include <majorminer_types.hpp>
+#include <lmrp/lmrp_heuristic.hpp>
+#include <lmrp/lmrp_crater_policy.hpp>
+
+namespace majorminer
+{
+
+  // Repairs overlapping target vertices in rounds. Each round claims
+  // non-overlapping craters through the subgraph generator, solves them in
+  // parallel on the unchanged state and applies the valid improvements.
+  // Placement and size of the craters are chosen by the CraterPolicy.
+  class LMRPManager
+  {
+    typedef std::unique_ptr<LMRPHeuristic> HeuristicPtr;
+
+    public:
+      LMRPManager(EmbeddingState& state, EmbeddingManager& embeddingManager)
+        : m_state(state), m_embeddingManager(embeddingManager), m_policy(state), m_nbRepairs(0) {}
+
+      void operator()();
+      // Repairs applied by the last run
+      fuint32_t getNbRepairs() const { return m_nbRepairs; }
+
+    private:
+      void claimCraters(LMRPSubgraph& gen, const Vector<vertex_t>& centers);
+      bool applyRepair(const LMRPHeuristic& heuristic);
+      bool isValidRepair(const nodeset_t& crater,
+        const UnorderedMap<vertex_t, nodeset_t>& superVertices) const;
+      bool isConnected(const nodeset_t& superVertex) const;
+
+    private:
+      EmbeddingState& m_state;
+      EmbeddingManager& m_embeddingManager;
+      CraterPolicy m_policy;
+
+      Vector<HeuristicPtr> m_heuristics;
+      Vector<vertex_t> m_claimed;
+      fuint32_t m_nbRepairs;
+  };
+
+}
+
+
+#endif
@@ -0,0 +1,20 @@
+#include <lmrp/lmrp_occupancy.hpp>
+
+using namespace majorminer;
+
+
+bool OccupancyGrid::tryOccupy(const fuint32_pair_t& cell)
+{
+  uint8_t expected = 0;
+  return m_cells[getIndex(cell)].compare_exchange_strong(expected, 1);
+}
+
+void OccupancyGrid::release(const fuint32_pair_t& cell)
+{
+  m_cells[getIndex(cell)].store(0);
+}
+
+bool OccupancyGrid::isOccupied(const fuint32_pair_t& cell) const
+{
+  return m_cells[getIndex(cell)].load() != 0;
+}
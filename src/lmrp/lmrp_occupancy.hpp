@@ -0,0 +1,81 @@
+#ifndef __MAJORMINER_LMRP_OCCUPANCY_HPP_
+#define __MAJORMINER_LMRP_OCCUPANCY_HPP_
+
+#include <majorminer_types.hpp>
+
+namespace majorminer
+{
+
+  // Dense grid of the cells claimed by craters. The crater cells are reserved
+  // one by one with compare-and-swap. If a cell is taken or a cell around the
+  // crater is occupied, the reservation is rolled back. Cells are passed to
+  // the functors as in the neighborhood() templates of the generators.
+  class OccupancyGrid
+  {
+    public:
+      OccupancyGrid(fuint32_t width, fuint32_t height)
+        : m_width(width), m_cells(width * height) {}
+
+      template<typename Neighborhood>
+      bool reserve(const Neighborhood& neighborhood)
+      {
+        bool success = true;
+        fuint32_t nbReserved = 0;
+        neighborhood([&](const fuint32_pair_t& cell, bool inCrater){
+          if (!inCrater || !success) return;
+          if (tryOccupy(cell)) nbReserved++;
+          else success = false;
+        });
+        if (success)
+        {
+          neighborhood([&](const fuint32_pair_t& cell, bool inCrater){
+            if (!inCrater && isOccupied(cell)) success = false;
+          });
+        }
+        if (!success)
+        { // crater cells are visited in the same order
+          neighborhood([&](const fuint32_pair_t& cell, bool inCrater){
+            if (inCrater && nbReserved > 0)
+            {
+              release(cell);
+              nbReserved--;
+            }
+          });
+        }
+        return success;
+      }
+
+      template<typename Neighborhood>
+      bool anyOccupied(const Neighborhood& neighborhood) const
+      {
+        bool occupied = false;
+        neighborhood([&](const fuint32_pair_t& cell, bool){
+          occupied |= isOccupied(cell);
+        });
+        return occupied;
+      }
+
+      template<typename Neighborhood>
+      void free(const Neighborhood& neighborhood)
+      {
+        neighborhood([&](const fuint32_pair_t& cell, bool inCrater){
+          if (inCrater) release(cell);
+        });
+      }
+
+    private:
+      bool tryOccupy(const fuint32_pair_t& cell);
+      void release(const fuint32_pair_t& cell);
+      bool isOccupied(const fuint32_pair_t& cell) const;
+      fuint32_t getIndex(const fuint32_pair_t& cell) const
+      { return cell.second * m_width + cell.first; }
+
+    private:
+      fuint32_t m_width;
+      Vector<std::atomic<uint8_t>> m_cells;
+  };
+
+}
+
+
+#endif
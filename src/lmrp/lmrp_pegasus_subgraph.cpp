@@ -0,0 +1,48 @@
+#include <lmrp/lmrp_pegasus_subgraph.hpp>
+
+using namespace majorminer;
+
+
+bool PegasusLMRPSubgraph::getSubgraph(vertex_t contained, nodeset_t& subgraph)
+{
+  fuint32_t x = m_graph.getXCoord(contained);
+  fuint32_t y = m_graph.getYCoord(contained);
+  auto cells = [&](auto func){ neighborhood(x, y, func); };
+  if (!m_occupied.reserve(cells)) return false;
+
+  subgraph.clear();
+  cells([&](const fuint32_pair_t& pair, bool inCrater){
+    if (inCrater) addCellVertices(pair, subgraph);
+  });
+  return true;
+}
+
+bool PegasusLMRPSubgraph::isBeingDestroyed(vertex_t contained)
+{
+  fuint32_t x = m_graph.getXCoord(contained);
+  fuint32_t y = m_graph.getYCoord(contained);
+  return m_occupied.anyOccupied([&](auto func){ neighborhood(x, y, func); });
+}
+
+void PegasusLMRPSubgraph::commit(vertex_t contained)
+{
+  fuint32_t x = m_graph.getXCoord(contained);
+  fuint32_t y = m_graph.getYCoord(contained);
+  m_occupied.free([&](auto func){ neighborhood(x, y, func); });
+}
+
+void PegasusLMRPSubgraph::addCellVertices(const fuint32_pair_t& cell, nodeset_t& subgraph) const
+{ // pair := (x_coord, y_coord)
+  fuint32_t size = m_graph.getWidth();
+  for (fuint32_t k = 0; k < 12; ++k)
+  {
+    if (cell.second + 1 < size && m_graph.isFabric(0, cell.first, k))
+    {
+      subgraph.insert(m_graph.getVertex(0, cell.first, k, cell.second));
+    }
+    if (cell.first + 1 < size && m_graph.isFabric(1, cell.second, k))
+    {
+      subgraph.insert(m_graph.getVertex(1, cell.second, k, cell.first));
+    }
+  }
+}
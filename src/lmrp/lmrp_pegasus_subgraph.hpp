@@ -0,0 +1,63 @@
+#ifndef __MAJORMINER_LMRP_PEGASUS_SUBGRAPH_HPP_
+#define __MAJORMINER_LMRP_PEGASUS_SUBGRAPH_HPP_
+
+#include <majorminer_types.hpp>
+#include <lmrp/lmrp_subgraph.hpp>
+#include <lmrp/lmrp_occupancy.hpp>
+#include <common/graph_info.hpp>
+
+namespace majorminer
+{
+
+  class PegasusLMRPSubgraph : public LMRPSubgraph
+  {
+    public:
+      PegasusLMRPSubgraph(PegasusGraphInfo& g)
+        : LMRPSubgraph(2), m_graph(g), m_occupied(g.getWidth(), g.getHeight()) {}
+      ~PegasusLMRPSubgraph() {}
+
+      bool getSubgraph(vertex_t contained, nodeset_t& subgraph) override;
+
+      bool isBeingDestroyed(vertex_t contained) override;
+
+      // If a LMRP instance was solved, free the mapped vertices
+      void commit(vertex_t contained) override;
+
+    private:
+      void addCellVertices(const fuint32_pair_t& cell, nodeset_t& subgraph) const;
+
+      // The crater consists of m_craterSize x m_craterSize cells. Neighbors
+      // of a qubit lie in adjacent cells, hence one ring around is checked.
+      template<typename Functor>
+      void neighborhood(fuint32_t x, fuint32_t y, Functor func) const
+      {
+        fuint32_t size = m_graph.getWidth();
+        fuint32_t craterSize = std::min(m_craterSize, size);
+        fuint32_t craterX = std::min(x, size - craterSize);
+        fuint32_t craterY = std::min(y, size - craterSize);
+
+        fuint32_t minX = craterX > 0 ? (craterX - 1) : 0;
+        fuint32_t maxX = std::min(craterX + craterSize + 1, size);
+        fuint32_t minY = craterY > 0 ? (craterY - 1) : 0;
+        fuint32_t maxY = std::min(craterY + craterSize + 1, size);
+
+        for (fuint32_t itX = minX; itX < maxX; ++itX)
+        {
+          for (fuint32_t itY = minY; itY < maxY; ++itY)
+          {
+            bool isInCrater = (itX >= craterX && itX < craterX + craterSize)
+              && (itY >= craterY && itY < craterY + craterSize);
+            func(fuint32_pair_t{itX, itY}, isInCrater);
+          }
+        }
+      }
+
+    private:
+      PegasusGraphInfo m_graph;
+      OccupancyGrid m_occupied;
+  };
+
+}
+
+
+#endif
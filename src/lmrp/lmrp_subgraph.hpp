@@ -9,6 +9,8 @@ namespace majorminer
   class LMRPSubgraph
   {
     public:
+      LMRPSubgraph(fuint32_t craterSize) : m_craterSize(craterSize) {}
+
       // Get a subgraph that contains the vertex "contained". Subgraph might not
       // be connected. If successful, method returns true.
       virtual bool getSubgraph(vertex_t contained, nodeset_t& subgraph) = 0;
@@ -17,6 +19,14 @@ namespace majorminer
 
       // If a LMRP instance was solved, free the mapped vertices
       virtual void commit(vertex_t contained) = 0;
+
+      // Extent of a crater in cells of the topology. Must not be changed
+      // while craters are claimed, as commit recomputes the claimed cells.
+      void setCraterSize(fuint32_t size) { m_craterSize = std::max(size, (fuint32_t)1); }
+      fuint32_t getCraterSize() const { return m_craterSize; }
+
+    protected:
+      fuint32_t m_craterSize;
   };
 }
 
@@ -30,7 +30,6 @@ bool DijkstraVertex::lowerTo(fuint32_t parent, fuint32_t overlap,
   if (overlap < m_overlapCnt || (overlap == m_overlapCnt
     && nonOverlap < m_nonOverlapCnt))
   {
-    //std::cout << "Changing parent from " << m_parent << " to " << parent << std::endl;
     m_parent = parent;
     m_overlapCnt = overlap;
     m_nonOverlapCnt = nonOverlap;
@@ -46,3 +45,54 @@ bool DijkstraVertex::visited()
   return original;
 }
 
+
+void DijkstraBucketQueue::push(fuint32_t local, fuint32_t overlaps, fuint32_t length)
+{
+  if (overlaps >= m_buckets.size()) m_buckets.resize(overlaps + 1);
+  auto& row = m_buckets[overlaps];
+  if (length >= row.size()) row.resize(length + 1);
+  row[length].push_back(local);
+  if (m_size == 0 || overlaps < m_overlaps || (overlaps == m_overlaps && length < m_length))
+  { // keys are mostly monotone, but seeds may be pushed in any order
+    m_overlaps = overlaps;
+    m_length = length;
+  }
+  m_size++;
+}
+
+bool DijkstraBucketQueue::pop(fuint32_t& local, fuint32_t& overlaps, fuint32_t& length)
+{
+  while (m_size > 0)
+  {
+    auto& row = m_buckets[m_overlaps];
+    if (m_length < row.size() && !row[m_length].empty())
+    {
+      local = row[m_length].back();
+      row[m_length].pop_back();
+      overlaps = m_overlaps;
+      length = m_length;
+      m_size--;
+      return true;
+    }
+    if (++m_length >= row.size())
+    {
+      m_overlaps++;
+      m_length = 0;
+    }
+  }
+  return false;
+}
+
+void DijkstraBucketQueue::clear()
+{ // buckets before the cursor are empty already
+  if (m_size > 0)
+  {
+    for (size_t idx = m_overlaps; idx < m_buckets.size(); ++idx)
+    {
+      for (auto& bucket : m_buckets[idx]) bucket.clear();
+    }
+  }
+  m_overlaps = 0;
+  m_length = 0;
+  m_size = 0;
+}
@@ -45,6 +45,9 @@ namespace majorminer
             && v1.m_nonOverlapCnt < v2.m_nonOverlapCnt);
       }
 
+      friend bool operator>(const DijkstraVertex& v1, const DijkstraVertex& v2)
+      { return v2 < v1; }
+
       friend bool operator==(const DijkstraVertex& v1, const DijkstraVertex& v2)
       { return v1.m_target == v2.m_target; }
 
@@ -54,6 +57,27 @@ namespace majorminer
       fuint32_t m_nonOverlapCnt;
       bool m_visited;
   };
+
+  // Priority queue for the lexicographic (overlaps, length) key of the
+  // LMRP Dijkstra. Both are small integers bounded by the crater size, so
+  // entries are kept in buckets and popped in key order by a cursor.
+  class DijkstraBucketQueue
+  {
+    public:
+      DijkstraBucketQueue() : m_overlaps(0), m_length(0), m_size(0) {}
+
+      void push(fuint32_t local, fuint32_t overlaps, fuint32_t length);
+      bool pop(fuint32_t& local, fuint32_t& overlaps, fuint32_t& length);
+      void clear();
+      bool empty() const { return m_size == 0; }
+      size_t size() const { return m_size; }
+
+    private:
+      Vector<Vector<Vector<fuint32_t>>> m_buckets; // [overlaps][length]
+      fuint32_t m_overlaps;
+      fuint32_t m_length;
+      size_t m_size;
+  };
 }
 
 
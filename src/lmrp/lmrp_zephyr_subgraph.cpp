@@ -0,0 +1,48 @@
+#include <lmrp/lmrp_zephyr_subgraph.hpp>
+
+using namespace majorminer;
+
+
+bool ZephyrLMRPSubgraph::getSubgraph(vertex_t contained, nodeset_t& subgraph)
+{
+  fuint32_t x = m_graph.getXCoord(contained);
+  fuint32_t y = m_graph.getYCoord(contained);
+  auto cells = [&](auto func){ neighborhood(x, y, func); };
+  if (!m_occupied.reserve(cells)) return false;
+
+  subgraph.clear();
+  cells([&](const fuint32_pair_t& pair, bool inCrater){
+    if (inCrater) addCellVertices(pair, subgraph);
+  });
+  return true;
+}
+
+bool ZephyrLMRPSubgraph::isBeingDestroyed(vertex_t contained)
+{
+  fuint32_t x = m_graph.getXCoord(contained);
+  fuint32_t y = m_graph.getYCoord(contained);
+  return m_occupied.anyOccupied([&](auto func){ neighborhood(x, y, func); });
+}
+
+void ZephyrLMRPSubgraph::commit(vertex_t contained)
+{
+  fuint32_t x = m_graph.getXCoord(contained);
+  fuint32_t y = m_graph.getYCoord(contained);
+  m_occupied.free([&](auto func){ neighborhood(x, y, func); });
+}
+
+void ZephyrLMRPSubgraph::addCellVertices(const fuint32_pair_t& cell, nodeset_t& subgraph) const
+{ // pair := (x_coord, y_coord)
+  fuint32_t size = m_graph.m_size;
+  for (fuint32_t k = 0; k < m_graph.m_tile; ++k)
+  {
+    if (cell.second / 2 < size)
+    {
+      subgraph.insert(m_graph.getVertex(0, cell.first, k, cell.second % 2, cell.second / 2));
+    }
+    if (cell.first / 2 < size)
+    {
+      subgraph.insert(m_graph.getVertex(1, cell.second, k, cell.first % 2, cell.first / 2));
+    }
+  }
+}
@@ -0,0 +1,64 @@
+#ifndef __MAJORMINER_LMRP_ZEPHYR_SUBGRAPH_HPP_
+#define __MAJORMINER_LMRP_ZEPHYR_SUBGRAPH_HPP_
+
+#include <majorminer_types.hpp>
+#include <lmrp/lmrp_subgraph.hpp>
+#include <lmrp/lmrp_occupancy.hpp>
+#include <common/graph_info.hpp>
+
+namespace majorminer
+{
+
+  class ZephyrLMRPSubgraph : public LMRPSubgraph
+  {
+    public:
+      ZephyrLMRPSubgraph(ZephyrGraphInfo& g)
+        : LMRPSubgraph(3), m_graph(g), m_occupied(g.getWidth(), g.getHeight()) {}
+      ~ZephyrLMRPSubgraph() {}
+
+      bool getSubgraph(vertex_t contained, nodeset_t& subgraph) override;
+
+      bool isBeingDestroyed(vertex_t contained) override;
+
+      // If a LMRP instance was solved, free the mapped vertices
+      void commit(vertex_t contained) override;
+
+    private:
+      void addCellVertices(const fuint32_pair_t& cell, nodeset_t& subgraph) const;
+
+      // The crater consists of m_craterSize x m_craterSize cells around the
+      // contained qubit. Qubits are coupled up to two cells apart, hence two
+      // rings are checked.
+      template<typename Functor>
+      void neighborhood(fuint32_t x, fuint32_t y, Functor func) const
+      {
+        fuint32_t size = m_graph.getWidth();
+        fuint32_t craterSize = std::min(m_craterSize, size);
+        fuint32_t craterX = std::min(x - std::min(x, craterSize / 2), size - craterSize);
+        fuint32_t craterY = std::min(y - std::min(y, craterSize / 2), size - craterSize);
+
+        fuint32_t minX = craterX > 2 ? (craterX - 2) : 0;
+        fuint32_t maxX = std::min(craterX + craterSize + 2, size);
+        fuint32_t minY = craterY > 2 ? (craterY - 2) : 0;
+        fuint32_t maxY = std::min(craterY + craterSize + 2, size);
+
+        for (fuint32_t itX = minX; itX < maxX; ++itX)
+        {
+          for (fuint32_t itY = minY; itY < maxY; ++itY)
+          {
+            bool isInCrater = (itX >= craterX && itX < craterX + craterSize)
+              && (itY >= craterY && itY < craterY + craterSize);
+            func(fuint32_pair_t{itX, itY}, isInCrater);
+          }
+        }
+      }
+
+    private:
+      ZephyrGraphInfo m_graph;
+      OccupancyGrid m_occupied;
+  };
+
+}
+
+
+#endif
@@ -4,6 +4,7 @@
 #include <common/utils.hpp>
 #include <common/embedding_validator.hpp>
 #include <common/embedding_visualizer.hpp>
+#include <common/embedding_trace.hpp>
 #include <common/cut_vertex.hpp>
 #include <common/time_measurement.hpp>
 
@@ -15,7 +16,16 @@ using namespace majorminer;
 EmbeddingSuite::EmbeddingSuite(const graph_t& source, const graph_t& target, EmbeddingVisualizer* visualizer)
   : m_state(source, target, visualizer), m_visualizer(visualizer),
     m_embeddingManager(*this, m_state), m_mutationManager(m_state, m_embeddingManager),
-    m_placer(m_state, m_embeddingManager), m_finished(false)
+    m_placer(m_state, m_embeddingManager), m_lmrpManager(m_state, m_embeddingManager),
+    m_finished(false)
+{ }
+
+EmbeddingSuite::EmbeddingSuite(const graph_t& source, const TargetTopology& topology,
+    const DefectMask& defects, EmbeddingVisualizer* visualizer)
+  : m_state(source, topology, &defects, visualizer), m_visualizer(visualizer),
+    m_embeddingManager(*this, m_state), m_mutationManager(m_state, m_embeddingManager),
+    m_placer(m_state, m_embeddingManager), m_lmrpManager(m_state, m_embeddingManager),
+    m_finished(false)
 { }
 
 void EmbeddingSuite::setSubgraphGen(LMRPSubgraph* generator)
@@ -23,18 +33,56 @@ void EmbeddingSuite::setSubgraphGen(LMRPSubgraph* generator)
   m_state.setLMRPSubgraphGenerator(generator);
 }
 
+void EmbeddingSuite::setConfig(const EmbeddingConfig& config)
+{
+  m_state.setConfig(config);
+}
+
+void EmbeddingSuite::setSeed(uint64_t seed)
+{
+  EmbeddingConfig config = m_state.getConfig();
+  config.m_deterministic = true;
+  config.m_seed = seed;
+  m_state.setConfig(config);
+}
+
 embedding_mapping_t EmbeddingSuite::find_embedding()
 {
   if (m_finished) return m_state.getMapping();
+  [[maybe_unused]] auto& profiler = m_state.getProfiler();
   const auto& nodesRemaining = m_state.getRemainingNodes();
+  recordPhase("placement");
   while(!nodesRemaining.empty())
   {
-    m_placer();
+    {
+      PROFILE_SCOPE(profiler, "placement")
+      m_placer();
+    }
+    PROFILE_SCOPE(profiler, "mutation")
     m_mutationManager();
   }
-  m_mutationManager(true);
-  m_placer.replaceOverlapping();
+  // the repair phases are skipped as soon as the embedding is valid
+  auto& tracker = m_state.getValidityTracker();
+  if (!tracker.isValid())
+  {
+    recordPhase("overlap reduction");
+    PROFILE_SCOPE(profiler, "overlap reduction")
+    m_mutationManager(true);
+  }
+  if (!tracker.isValid())
+  {
+    recordPhase("lmrp");
+    PROFILE_SCOPE(profiler, "lmrp")
+    m_lmrpManager();
+  }
+  if (!tracker.isValid())
+  {
+    recordPhase("replace overlapping");
+    PROFILE_SCOPE(profiler, "replace overlapping")
+    m_placer.replaceOverlapping();
+  }
   if (m_visualizer != nullptr) finishVisualization();
+  if (m_state.getTrace() != nullptr) m_state.getTrace()->flush();
   m_finished = true;
   return m_state.getMapping();
 }
@@ -49,7 +97,13 @@ bool EmbeddingSuite::isValid() const
 bool EmbeddingSuite::connectsNodes() const
 {
   EmbeddingValidator validator{m_state};
-  return validator.nodesConnected();
+  ValidationReport report = validator.validate();
+  return report.avoidsDefects() && report.edgesCovered();
+}
+
+void EmbeddingSuite::recordPhase(const char* label)
+{
+  if (m_state.getTrace() != nullptr) m_state.getTrace()->recordPhase(label);
 }
 
 void EmbeddingSuite::finishVisualization()
@@ -58,5 +112,6 @@ void EmbeddingSuite::finishVisualization()
   std::stringstream ss;
   ss  << "Final iteration. Distinct overlaps: " << stats.first
       << "; Total overlaps: " << stats.second << std::endl;
-  m_visualizer->draw(m_state.getMapping(), ss.str().c_str());
+  m_visualizer->draw(m_state.getMapping(), ss.str().c_str(), true);
+  m_visualizer->flush();
 }
@@ -5,6 +5,7 @@
 #include <common/embedding_state.hpp>
 #include <initial/super_vertex_placer.hpp>
 #include <evolutionary/mutation_manager.hpp>
+#include <lmrp/lmrp_manager.hpp>
 
 namespace majorminer
 {
@@ -12,14 +13,32 @@ namespace majorminer
   {
     public:
       EmbeddingSuite(const graph_t& source, const graph_t& target, EmbeddingVisualizer* visualizer = nullptr);
+      // Embeds into the active part of a cached topology, see DefectMask.
+      // Topology and defects are not copied and have to outlive the suite.
+      EmbeddingSuite(const graph_t& source, const TargetTopology& topology,
+        const DefectMask& defects, EmbeddingVisualizer* visualizer = nullptr);
+      EmbeddingSuite(const graph_t& source, TargetTopology&& topology,
+        const DefectMask& defects, EmbeddingVisualizer* visualizer = nullptr) = delete;
 
       embedding_mapping_t find_embedding();
       bool isValid() const;
       bool connectsNodes() const;
       void setSubgraphGen(LMRPSubgraph* generator);
+      void setConfig(const EmbeddingConfig& config);
+      // Enables the deterministic mode with the given seed
+      void setSeed(uint64_t seed);
+      const EmbeddingConfig& getConfig() const { return m_state.getConfig(); }
+      // Counters of the current embedding, updated with every change
+      ValidityTracker& getValidityTracker() { return m_state.getValidityTracker(); }
+      // Collects a breakdown of the phases per thread, see Profiler
+      void setProfiling(bool enabled) { m_state.getProfiler().setEnabled(enabled); }
+      ProfileReport getProfile() const { return m_state.getProfiler().report(); }
+      // Records every change and the phases to the trace, see TraceReplay
+      void setTrace(EmbeddingTrace* trace) { m_state.setTrace(trace); }
 
     private:
       void finishVisualization();
+      void recordPhase(const char* label);
 
     private:
       EmbeddingState m_state;
@@ -27,6 +46,7 @@ namespace majorminer
       EmbeddingManager m_embeddingManager;
       MutationManager m_mutationManager;
       SuperVertexPlacer m_placer;
+      LMRPManager m_lmrpManager;
 
       Queue<std::unique_ptr<GenericMutation>> m_taskQueue;
 
@@ -105,6 +105,7 @@ namespace majorminer
 
   typedef UnorderedMap<vertex_t, fuint32_t> VertexNumberMap;
   typedef UnorderedSet<edge_t, PairHashFunc<vertex_t>> graph_t;
+  typedef Vector<edge_t> edge_list_t;
   typedef UnorderedMultiMap<vertex_t, vertex_t> adjacency_list_t;
   typedef adjacency_list_t embedding_mapping_t;
   typedef UnorderedSet<vertex_t> nodeset_t;
@@ -117,7 +118,9 @@ namespace majorminer
   typedef Cache<vertex_t, ShiftingCandidates> CandidateCache;
 
   struct ChimeraGraphInfo;
+  struct EmbeddingConfig;
   class EmbeddingVisualizer;
+  class EmbeddingTrace;
   class EmbeddingSuite;
   class EmbeddingBase;
   class EmbeddingState;
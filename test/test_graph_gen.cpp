@@ -1,6 +1,16 @@
 #include "utils/test_common.hpp"
 
 #include <common/graph_gen.hpp>
+#include <common/graph_info.hpp>
+#include <common/graph_io.hpp>
+#include <common/csr_graph.hpp>
+#include <common/target_topology.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <type_traits>
 
 using namespace majorminer;
 
@@ -56,6 +66,66 @@ TEST(KingGraphGen, King_3x3)
   });
 }
 
+TEST(PegasusGraphGen, Pegasus_16)
+{
+  auto graph = majorminer::generate_pegasus(16);
+  EXPECT_EQ(graph.size(), 40484);
+  EXPECT_EQ(getNodeset(graph).size(), 5640);
+  containsEdges(graph, {
+    {30, 31}, {30, 45}
+  });
+}
+
+TEST(PegasusGraphGen, Pegasus_Neighbors)
+{
+  auto graph = majorminer::generate_pegasus(4);
+  PegasusGraphInfo info{4};
+  for (const auto& edge : graph)
+  { // neighbors are symmetric and lie in adjacent cells (see LMRP craters)
+    bool found = false;
+    info.iterateNeighbors(edge.second, [&](vertex_t adjacent){ found |= adjacent == edge.first; });
+    EXPECT_TRUE(found);
+    EXPECT_LE(std::abs((int)info.getXCoord(edge.first) - (int)info.getXCoord(edge.second)), 1);
+    EXPECT_LE(std::abs((int)info.getYCoord(edge.first) - (int)info.getYCoord(edge.second)), 1);
+  }
+}
+
+TEST(ZephyrGraphGen, Zephyr_6_4)
+{
+  auto graph = majorminer::generate_zephyr(6, 4);
+  EXPECT_EQ(getNodeset(graph).size(), 1248);
+  EXPECT_EQ(graph.size(), 11400);
+
+  ZephyrGraphInfo info{6, 4};
+  adjacency_list_t adjacency{};
+  for (const auto& edge : graph)
+  {
+    adjacency.insert(edge);
+    adjacency.insert(std::make_pair(edge.second, edge.first));
+  }
+  // interior qubits have 4t internal, two odd and two external couplers
+  EXPECT_EQ(adjacency.count(info.getVertex(0, 5, 1, 0, 2)), 20);
+  EXPECT_EQ(adjacency.count(info.getVertex(1, 6, 3, 1, 3)), 20);
+}
+
+TEST(ZephyrGraphGen, Zephyr_Edge_List)
+{
+  auto edges = majorminer::generate_zephyr_edges(3, 2);
+  ASSERT_FALSE(edges.empty());
+  EXPECT_TRUE(std::is_sorted(edges.begin(), edges.end()));
+  EXPECT_TRUE(std::adjacent_find(edges.begin(), edges.end()) == edges.end());
+  ZephyrGraphInfo info{3, 2};
+  for (const auto& edge : edges)
+  { // neighbors are symmetric and at most two cells apart (see LMRP craters)
+    EXPECT_LT(edge.first, edge.second);
+    bool found = false;
+    info.iterateNeighbors(edge.second, [&](vertex_t adjacent){ found |= adjacent == edge.first; });
+    EXPECT_TRUE(found);
+    EXPECT_LE(std::abs((int)info.getXCoord(edge.first) - (int)info.getXCoord(edge.second)), 2);
+    EXPECT_LE(std::abs((int)info.getYCoord(edge.first) - (int)info.getYCoord(edge.second)), 2);
+  }
+}
+
 TEST(ImportGraphEdgeList, SimpleEdgeList)
 {
   auto graph = majorminer::import_graph("test/data/sample_edgelists/simple_edgelist.txt");
@@ -73,6 +143,165 @@ TEST(ImportGraphEdgeList, EmptyEdgeList)
   EXPECT_EQ(graph.size(), 0);
 }
 
+TEST(ImportGraphEdgeList, Parallel_Parse)
+{
+  CSRGraph pegasus = CSRGraph::fromGraph(majorminer::generate_pegasus(16));
+  edge_list_t expected = pegasus.toEdgeList();
+  std::stringstream ss;
+  ss << "[";
+  for (size_t idx = 0; idx < expected.size(); ++idx)
+  {
+    ss << (idx == 0 ? "" : ",\n ") << "[" << expected[idx].first << ", " << expected[idx].second << "]";
+  }
+  ss << "]";
+  std::string content = ss.str();
+  ASSERT_GT(content.size(), 1U << 18); // split into several chunks
+
+  edge_list_t edges = majorminer::parse_edge_list(content.c_str(), content.size());
+  EXPECT_EQ(edges, expected);
+}
+
+TEST(ImportGraphEdgeList, Bad_Edge_Lists)
+{
+  auto parse = [](const std::string& content){ return majorminer::parse_edge_list(content.c_str(), content.size()); };
+  EXPECT_THROW(parse("[[0,1], x [1,2]]"), std::runtime_error);
+  EXPECT_THROW(parse("[[0,1,2]]"), std::runtime_error);
+  EXPECT_THROW(parse("[[0]]"), std::runtime_error);
+  EXPECT_THROW(parse("[[0,a]]"), std::runtime_error);
+  EXPECT_THROW(parse("[[0,1]"), std::runtime_error);
+  EXPECT_EQ(parse(" [ [3, 4] ,[5,6] ] ").size(), 2);
+}
+
+TEST(CSRGraph, From_Edge_List)
+{
+  CSRGraph graph = CSRGraph::fromEdgeList({ {1,0}, {0,1}, {2,2}, {2,1}, {0,2} }, 5);
+  EXPECT_EQ(graph.getNbVertices(), 5);
+  EXPECT_EQ(graph.getNbEdges(), 3);
+  EXPECT_EQ(graph.getDegree(0), 2);
+  EXPECT_EQ(graph.getDegree(4), 0);
+  EXPECT_TRUE(graph.hasEdge(2, 0));
+  EXPECT_FALSE(graph.hasEdge(2, 2));
+  EXPECT_FALSE(graph.hasEdge(3, 4));
+  edge_list_t expected = { {0,1}, {0,2}, {1,2} };
+  EXPECT_EQ(graph.toEdgeList(), expected);
+  EXPECT_EQ(graph.toGraph().size(), 3);
+}
+
+TEST(CSRGraph, Binary_Round_Trip)
+{
+  graph_t chimera = majorminer::generate_chimera(4, 4);
+  CSRGraph graph = CSRGraph::fromGraph(chimera);
+  const std::string filename = "chimera_4_4.mmcsr";
+  majorminer::export_binary_graph(filename, graph);
+  {
+    CSRGraph imported = majorminer::import_binary_graph(filename);
+    EXPECT_EQ(imported.getNbVertices(), graph.getNbVertices());
+    EXPECT_EQ(imported.toEdgeList(), graph.toEdgeList());
+    EXPECT_EQ(imported.toGraph().size(), chimera.size());
+  }
+  std::remove(filename.c_str());
+
+  EXPECT_THROW(majorminer::import_binary_graph("test/data/sample_edgelists/simple_edgelist.txt"), std::runtime_error);
+}
+
+TEST(CSRGraph, Binary_Rejects_Corrupt_Files)
+{
+  // header: 8 bytes magic, version, number of vertices, 64 bit number of arcs
+  const size_t nbArcsPos = 16, offsetsPos = 24;
+  graph_t cycle = majorminer::generate_cyclegraph(4);
+  const std::string filename = "cycle_4.mmcsr";
+  majorminer::export_binary_graph(filename, CSRGraph::fromGraph(cycle));
+  std::string original{};
+  {
+    std::ifstream file(filename, std::ios::binary);
+    original.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  auto importPatched = [&](size_t pos, const void* value, size_t size){
+    std::string patched = original;
+    patched.replace(pos, size, reinterpret_cast<const char*>(value), size);
+    {
+      std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+      file.write(patched.data(), patched.size());
+    }
+    return majorminer::import_binary_graph(filename);
+  };
+
+  uint64_t hugeArcs = (1ULL << 62) - 5;
+  EXPECT_THROW(importPatched(nbArcsPos, &hugeArcs, sizeof(hugeArcs)), std::runtime_error);
+  uint32_t decreasing = 7; // offsets of a 4-cycle are 0 2 4 6 8
+  EXPECT_THROW(importPatched(offsetsPos + 1 * sizeof(uint32_t), &decreasing, sizeof(decreasing)), std::runtime_error);
+  uint32_t outOfRange = 4;
+  EXPECT_THROW(importPatched(offsetsPos + 5 * sizeof(uint32_t), &outOfRange, sizeof(outOfRange)), std::runtime_error);
+  uint32_t valid = 2;
+  EXPECT_NO_THROW(importPatched(offsetsPos + 1 * sizeof(uint32_t), &valid, sizeof(valid)));
+  std::remove(filename.c_str());
+}
+
+TEST(CSRGraph, Defect_Mask)
+{
+  graph_t king = majorminer::generate_king(3, 3);
+  TargetTopology topology{king};
+  DefectMask defects{topology};
+  EXPECT_TRUE(defects.isEdgeActive(0, 4));
+  EXPECT_FALSE(defects.isEdgeActive(0, 8)); // not an edge
+  defects.deactivateVertex(4);
+  defects.deactivateEdge(1, 0);
+  defects.deactivateEdge(0, 1);
+  EXPECT_EQ(defects.getNbInactiveVertices(), 1);
+  EXPECT_EQ(defects.getNbInactiveEdges(), 1);
+  EXPECT_FALSE(defects.isVertexActive(4));
+  EXPECT_FALSE(defects.isEdgeActive(0, 4));
+  EXPECT_FALSE(defects.isEdgeActive(0, 1));
+  EXPECT_FALSE(defects.isEdgeActive(1, 0));
+  EXPECT_TRUE(defects.isEdgeActive(0, 3));
+  EXPECT_FALSE(defects.isEdgeActive(0, 8));
+  EXPECT_FALSE(defects.isEdgeActive(0, 0));
+  EXPECT_THROW(defects.deactivateEdge(0, 8), std::runtime_error);
+  defects.clear();
+  EXPECT_TRUE(defects.isEdgeActive(0, 1));
+  EXPECT_TRUE(defects.isVertexActive(4));
+}
+
+TEST(CSRGraph, Topology_Owns_Graph)
+{
+  std::unique_ptr<TargetTopology> topology{};
+  {
+    graph_t king = majorminer::generate_king(3, 3);
+    topology = std::make_unique<TargetTopology>(king);
+  }
+  graph_t king = majorminer::generate_king(3, 3);
+  EXPECT_EQ(topology->getGraph().size(), king.size());
+  for (const auto& edge : king) EXPECT_TRUE(topology->getGraph().contains(edge));
+  static_assert(!std::is_constructible_v<DefectMask, TargetTopology&&>);
+}
+
+TEST(ErdosRenyiGraphGen, Edge_Count_And_Seed)
+{
+  CSRGraph graph = majorminer::generate_erdosrenyi_csr(10000, 0.001, 42);
+  EXPECT_EQ(graph.getNbVertices(), 10000);
+  EXPECT_NEAR(graph.getNbEdges(), 49995, 2500); // > 10 standard deviations
+  for (vertex_t vertex = 0; vertex < graph.getNbVertices(); ++vertex)
+  {
+    const uint32_t* begin = graph.getAdjacency() + graph.getOffsets()[vertex];
+    const uint32_t* end = graph.getAdjacency() + graph.getOffsets()[vertex + 1];
+    ASSERT_TRUE(std::adjacent_find(begin, end, std::greater_equal<uint32_t>()) == end);
+    graph.iterateAdjacent(vertex, [&](vertex_t adjacent){ ASSERT_TRUE(graph.hasEdge(adjacent, vertex)); });
+  }
+
+  CSRGraph same = majorminer::generate_erdosrenyi_csr(10000, 0.001, 42);
+  EXPECT_EQ(same.toEdgeList(), graph.toEdgeList());
+  CSRGraph other = majorminer::generate_erdosrenyi_csr(10000, 0.001, 43);
+  EXPECT_NE(other.toEdgeList(), graph.toEdgeList());
+}
+
+TEST(ErdosRenyiGraphGen, Extreme_Probabilities)
+{
+  EXPECT_EQ(majorminer::generate_erdosrenyi_csr(100, 0.0, 1).getNbEdges(), 0);
+  EXPECT_EQ(majorminer::generate_erdosrenyi_csr(100, 1.0, 1).getNbEdges(), 4950);
+  EXPECT_EQ(majorminer::generate_erdosrenyi(70, 1.0).size(), 2415);
+  EXPECT_EQ(majorminer::generate_erdosrenyi_csr(0, 0.5, 1).getNbVertices(), 0);
+}
+
 TEST(CycleGraphGen, Cycle_5)
 {
   auto graph = majorminer::generate_cyclegraph(5);
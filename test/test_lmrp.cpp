@@ -4,9 +4,13 @@
 #include <common/embedding_analyzer.hpp>
 #include <common/graph_gen.hpp>
 #include <common/debug_utils.hpp>
+#include <common/embedding_validator.hpp>
 #include <lmrp/lmrp_chimera_subgraph.hpp>
 #include <lmrp/lmrp_king_subgraph.hpp>
+#include <lmrp/lmrp_pegasus_subgraph.hpp>
+#include <lmrp/lmrp_zephyr_subgraph.hpp>
 #include <lmrp/lmrp_heuristic.hpp>
+#include <lmrp/lmrp_crater_policy.hpp>
 
 #include "utils/test_common.hpp"
 #include "utils/state_gen.hpp"
@@ -70,4 +74,291 @@ TEST(LMRPTest, TrivialKings_SingleConnection)
   LMRPHeuristic lmrp{*state, 24};
   lmrp.optimize();
   auto repaired = lmrp.getMapping();
-}
\ No newline at end of file
+}
+
+TEST(LMRPTest, Pegasus_Crater_Claims)
+{
+  PegasusGraphInfo info{6};
+  PegasusLMRPSubgraph gen{info};
+  nodeset_t crater{};
+  vertex_t first = info.getVertex(0, 0, 5, 0);
+  ASSERT_TRUE(gen.getSubgraph(first, crater));
+  EXPECT_TRUE(crater.contains(first));
+  for (vertex_t target : crater)
+  {
+    EXPECT_LT(info.getXCoord(target), 2);
+    EXPECT_LT(info.getYCoord(target), 2);
+  }
+
+  vertex_t second = info.getVertex(1, 3, 3, 3);
+  ASSERT_TRUE(gen.getSubgraph(second, crater));
+  EXPECT_EQ(crater.size(), 4 * 24);
+
+  vertex_t between = info.getVertex(0, 2, 0, 2);
+  EXPECT_TRUE(gen.isBeingDestroyed(between));
+  EXPECT_FALSE(gen.getSubgraph(between, crater));
+  gen.commit(first);
+  EXPECT_TRUE(gen.isBeingDestroyed(between));
+  gen.commit(second);
+  EXPECT_FALSE(gen.isBeingDestroyed(between));
+  ASSERT_TRUE(gen.getSubgraph(between, crater));
+  EXPECT_EQ(crater.size(), 4 * 24);
+}
+
+TEST(LMRPTest, Zephyr_Crater_Claims)
+{
+  ZephyrGraphInfo info{6, 2};
+  ZephyrLMRPSubgraph gen{info};
+  nodeset_t crater{};
+  vertex_t center = info.getVertex(1, 4, 1, 0, 2);
+  ASSERT_TRUE(gen.getSubgraph(center, crater));
+  EXPECT_TRUE(crater.contains(center));
+  EXPECT_EQ(crater.size(), 9 * 2 * 2);
+
+  EXPECT_TRUE(gen.isBeingDestroyed(info.getVertex(0, 8, 0, 0, 3)));
+  EXPECT_FALSE(gen.isBeingDestroyed(info.getVertex(0, 12, 0, 1, 5)));
+  gen.commit(center);
+  EXPECT_FALSE(gen.isBeingDestroyed(info.getVertex(0, 8, 0, 0, 3)));
+}
+
+TEST(LMRPTest, Concurrent_Crater_Claims)
+{
+  KingGraphInfo info{32, 32};
+  KingLMRPSubgraph gen{info};
+  tbb::concurrent_vector<vertex_t> claimed{};
+  tbb::concurrent_vector<vertex_t> craterVertices{};
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, 32 * 32, 1),
+    [&](const tbb::blocked_range<size_t>& range) {
+      for (auto idx = range.begin(); idx != range.end(); ++idx)
+      {
+        nodeset_t crater{};
+        if (!gen.getSubgraph(idx, crater)) continue;
+        claimed.push_back(idx);
+        for (vertex_t target : crater) craterVertices.push_back(target);
+      }
+  });
+  ASSERT_FALSE(claimed.empty());
+  nodeset_t unique{craterVertices.begin(), craterVertices.end()};
+  EXPECT_EQ(unique.size(), craterVertices.size());
+
+  for (vertex_t center : claimed) gen.commit(center);
+  for (vertex_t target = 0; target < 32 * 32; ++target)
+  {
+    EXPECT_FALSE(gen.isBeingDestroyed(target));
+  }
+}
+
+TEST(LMRPTest, King_Crater_Size)
+{
+  KingGraphInfo info{9, 9};
+  KingLMRPSubgraph gen{info};
+  nodeset_t crater{};
+  ASSERT_TRUE(gen.getSubgraph(40, crater));
+  EXPECT_EQ(crater.size(), 25);
+  gen.commit(40);
+
+  gen.setCraterSize(1);
+  ASSERT_TRUE(gen.getSubgraph(40, crater));
+  EXPECT_EQ(crater.size(), 9);
+  EXPECT_TRUE(crater.contains(30) && crater.contains(50));
+  EXPECT_FALSE(gen.isBeingDestroyed(0));
+  gen.commit(40);
+}
+
+TEST(LMRPTest, CraterPolicy_Hotspots_And_Size)
+{
+  auto king = majorminer::generate_king(6, 6);
+  graph_t source{ {0, 1}, {1, 2}, {2, 3} };
+  StateGen stateGen{source, king};
+  stateGen.addMapping(0, {7, 14});
+  stateGen.addMapping(1, {7, 8});
+  stateGen.addMapping(2, {7, 28});
+  stateGen.addMapping(3, {28, 29});
+  auto state = stateGen.get();
+
+  KingGraphInfo info{6, 6};
+  KingLMRPSubgraph gen{info};
+  CraterPolicy policy{*state};
+  policy.start(gen);
+  Vector<vertex_t> centers{};
+  policy.selectCenters(centers, 0);
+  std::sort(centers.begin(), centers.end());
+  EXPECT_EQ(centers, (Vector<vertex_t>{7, 28}));
+
+  policy.update(gen, 4, 0, 1.0);
+  EXPECT_TRUE(policy.changedSize());
+  EXPECT_EQ(gen.getCraterSize(), 3);
+  policy.update(gen, 4, 0, 1.0);
+  policy.update(gen, 4, 0, 1.0);
+  EXPECT_EQ(gen.getCraterSize(), 4); // maximal growth reached
+  EXPECT_FALSE(policy.changedSize());
+  policy.update(gen, 1, 1, 1000.0);
+  EXPECT_EQ(gen.getCraterSize(), 3); // over the time budget
+  policy.finish(gen);
+  EXPECT_EQ(gen.getCraterSize(), 2);
+
+  // seeded runs ignore the solve time
+  EmbeddingConfig config{};
+  config.m_deterministic = true;
+  state->setConfig(config);
+  policy.start(gen);
+  policy.update(gen, 1, 1, 1000.0);
+  EXPECT_FALSE(policy.changedSize());
+  EXPECT_EQ(gen.getCraterSize(), 2);
+  policy.finish(gen);
+}
+
+TEST(LMRPTest, DijkstraBucketQueue_Order)
+{
+  DijkstraBucketQueue queue{};
+  queue.push(0, 1, 0);
+  queue.push(1, 0, 3);
+  queue.push(2, 0, 1);
+  fuint32_t local, overlaps, length;
+  ASSERT_TRUE(queue.pop(local, overlaps, length));
+  EXPECT_EQ(local, 2);
+  queue.push(3, 0, 2);
+  queue.push(4, 0, 0); // below the cursor
+  Vector<fuint32_t> order{};
+  while (queue.pop(local, overlaps, length)) order.push_back(local);
+  EXPECT_EQ(order, (Vector<fuint32_t>{4, 3, 1, 0}));
+  EXPECT_TRUE(queue.empty());
+
+  queue.push(5, 2, 2);
+  queue.clear();
+  EXPECT_FALSE(queue.pop(local, overlaps, length));
+}
+
+namespace
+{
+  struct RepairResult
+  {
+    fuint32_t m_nbRepairs;
+    fuint32_t m_overlapsBefore;
+    fuint32_t m_overlapsAfter;
+    bool m_connected;
+    Vector<fuint32_pair_t> m_mapping; // sorted
+  };
+
+  // Maps the whole source graph onto the vertex of maximal degree and runs
+  // the repair phase on the overlapping embedding
+  RepairResult runRepairPhase(const graph_t& source, const graph_t& target, LMRPSubgraph& subgraph,
+    const EmbeddingConfig& config = EmbeddingConfig{})
+  {
+    UnorderedMap<vertex_t, fuint32_t> degrees{};
+    for (const auto& arc : target)
+    {
+      degrees[arc.first]++;
+      degrees[arc.second]++;
+    }
+    vertex_t center = FUINT32_UNDEF;
+    for (const auto& degree : degrees)
+    {
+      if (center == FUINT32_UNDEF || degree.second > degrees[center]
+        || (degree.second == degrees[center] && degree.first < center)) center = degree.first;
+    }
+    nodeset_t sourceVertices{};
+    for (const auto& arc : source)
+    {
+      sourceVertices.insert(arc.first);
+      sourceVertices.insert(arc.second);
+    }
+
+    StateGen gen{source, target};
+    auto state = gen.get();
+    state->setConfig(config);
+    state->setLMRPSubgraphGenerator(&subgraph);
+    EmbeddingSuite suite{source, target};
+    EmbeddingManager manager{suite, *state};
+    for (vertex_t sourceVertex : sourceVertices) manager.insertMappingPair(sourceVertex, center);
+    manager.occupyNode(center);
+    manager.commit();
+    manager.synchronize();
+
+    RepairResult result{};
+    auto& tracker = state->getValidityTracker();
+    result.m_overlapsBefore = tracker.getNbOverlappedTargets();
+    LMRPManager lmrp{*state, manager};
+    lmrp();
+    result.m_nbRepairs = lmrp.getNbRepairs();
+    result.m_overlapsAfter = tracker.getNbOverlappedTargets();
+    EmbeddingValidator validator{*state};
+    result.m_connected = validator.nodesConnected();
+    const auto& mapping = state->getMapping();
+    result.m_mapping.assign(mapping.begin(), mapping.end());
+    std::sort(result.m_mapping.begin(), result.m_mapping.end());
+    return result;
+  }
+}
+
+TEST(LMRPTest, Chimera_Repair_Phase)
+{
+  graph_t cycle = generate_cyclegraph(4);
+  graph_t chimera = generate_chimera(7, 7);
+  ChimeraGraphInfo info{7,7};
+  ChimeraLMRPSubgraph subgraph{info};
+  auto result = runRepairPhase(cycle, chimera, subgraph);
+  EXPECT_EQ(result.m_overlapsBefore, 1);
+  EXPECT_GT(result.m_nbRepairs, 0);
+  EXPECT_LT(result.m_overlapsAfter, result.m_overlapsBefore);
+  EXPECT_TRUE(result.m_connected);
+}
+
+TEST(LMRPTest, Kings_Repair_Phase)
+{
+  graph_t clique = generate_completegraph(4);
+  graph_t king = generate_king(8, 8);
+  KingGraphInfo info{8,8};
+  KingLMRPSubgraph subgraph{info};
+  auto result = runRepairPhase(clique, king, subgraph);
+  EXPECT_EQ(result.m_overlapsBefore, 1);
+  EXPECT_GT(result.m_nbRepairs, 0);
+  EXPECT_LT(result.m_overlapsAfter, result.m_overlapsBefore);
+  EXPECT_TRUE(result.m_connected);
+}
+
+TEST(LMRPTest, Pegasus_Repair_Phase)
+{
+  graph_t clique = generate_completegraph(4);
+  graph_t pegasus = generate_pegasus(4);
+  PegasusGraphInfo info{4};
+  PegasusLMRPSubgraph subgraph{info};
+  auto result = runRepairPhase(clique, pegasus, subgraph);
+  EXPECT_EQ(result.m_overlapsBefore, 1);
+  EXPECT_GT(result.m_nbRepairs, 0);
+  EXPECT_LT(result.m_overlapsAfter, result.m_overlapsBefore);
+  EXPECT_TRUE(result.m_connected);
+}
+
+TEST(LMRPTest, Zephyr_Repair_Phase)
+{
+  graph_t clique = generate_completegraph(4);
+  graph_t zephyr = generate_zephyr(2, 4);
+  ZephyrGraphInfo info{2, 4};
+  ZephyrLMRPSubgraph subgraph{info};
+  auto result = runRepairPhase(clique, zephyr, subgraph);
+  EXPECT_EQ(result.m_overlapsBefore, 1);
+  EXPECT_GT(result.m_nbRepairs, 0);
+  EXPECT_LT(result.m_overlapsAfter, result.m_overlapsBefore);
+  EXPECT_TRUE(result.m_connected);
+}
+
+TEST(LMRPTest, Deterministic_Repair_Phase)
+{
+  graph_t clique = generate_completegraph(5);
+  graph_t king = generate_king(8, 8);
+  KingGraphInfo info{8,8};
+  EmbeddingConfig config{};
+  config.m_deterministic = true;
+  config.m_seed = 1234;
+  config.m_lmrp.m_craterTimeBudgetMs = 0.0; // every crater is over the budget
+  auto run = [&](){
+    KingLMRPSubgraph subgraph{info};
+    return runRepairPhase(clique, king, subgraph, config);
+  };
+  auto first = run();
+  auto second = run();
+  EXPECT_GT(first.m_nbRepairs, 0);
+  EXPECT_EQ(first.m_nbRepairs, second.m_nbRepairs);
+  EXPECT_EQ(first.m_mapping, second.m_mapping);
+}
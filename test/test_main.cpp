@@ -2,11 +2,20 @@
 #include <majorminer.hpp>
 #include <common/embedding_visualizer.hpp>
 #include <common/embedding_analyzer.hpp>
+#include <common/embedding_trace.hpp>
 #include <common/graph_gen.hpp>
 #include <common/debug_utils.hpp>
+#include <common/target_topology.hpp>
+#include <common/random_gen.hpp>
+#include <common/utils.hpp>
+#include <initial/network_simplex.hpp>
+
+#include <filesystem>
+#include <fstream>
 
 #include "utils/test_common.hpp"
 #include "utils/qubo_problems.hpp"
+#include "utils/state_gen.hpp"
 
 using namespace majorminer;
 
@@ -45,6 +54,15 @@ namespace
     if (fullValidation) ASSERT_TRUE(suite.isValid());
     else ASSERT_TRUE(suite.connectsNodes());
   }
+  fuint32_t countFiles(const std::string& directory, const std::string& extension)
+  {
+    fuint32_t nbFiles = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory))
+    {
+      if (entry.path().extension() == extension) nbFiles++;
+    }
+    return nbFiles;
+  }
 }
 
 TEST(EmbeddingTest, Basic_Cycle_4)
@@ -140,6 +158,77 @@ TEST(EmbeddingTest, Complete_Graph_25_On_8_8_Chimera)
   clique_test(25, 8, 8, "imgs/Complete_Graph_25_On_8_8_Chimera/chimera_clique_25", false, false);
 }
 
+TEST(EmbeddingTest, Complete_Graph_15_Flat_Placement_Costs)
+{
+  graph_t clique = generate_completegraph(15);
+  graph_t chimera = generate_chimera(7, 7);
+  EmbeddingConfig config{};
+  config.m_placementCosts.m_overlapBase = 1.0;
+  config.m_placementCosts.m_chainLengthWeight = 0.0;
+  EmbeddingSuite suite{clique, chimera};
+  suite.setConfig(config);
+  auto embedding = suite.find_embedding();
+  ASSERT_TRUE(suite.connectsNodes());
+}
+
+TEST(EmbeddingTest, Placement_Cost_Model)
+{
+  graph_t cycle = generate_cyclegraph(4);
+  graph_t chimera = generate_chimera(2, 2);
+  StateGen gen{cycle, chimera};
+  gen.addMapping(0, { 10, 11, 12 });
+  gen.addMapping(1, { 10, 11 });
+  gen.addMapping(2, { 20 });
+  gen.addMapping(3, { 10, 21 });
+  auto state = gen.get();
+  EmbeddingSuite suite{cycle, chimera};
+  EmbeddingManager manager{suite, *state};
+  NetworkSimplexWrapper wrapper{*state, manager};
+
+  // defaults: free 1, occupied 10, overlap base 4, chain length weight 1
+  EXPECT_EQ(wrapper.determineCost(30), 1);
+  EXPECT_EQ(wrapper.determineCost(20), 10 + 1);
+  EXPECT_EQ(wrapper.determineCost(21), 10 + 2);
+  EXPECT_EQ(wrapper.determineCost(12), 10 + 3);
+
+  // the wrapper reads the config of the state, so later changes apply
+  EmbeddingConfig config{};
+  config.m_placementCosts.m_chainLengthWeight = 0.0;
+  state->setConfig(config);
+  EXPECT_EQ(wrapper.determineCost(12), 10);
+  EXPECT_EQ(wrapper.determineCost(11), 40);
+  EXPECT_EQ(wrapper.determineCost(10), 160);
+
+  config.m_placementCosts.m_chainLengthWeight = 2.5;
+  config.m_placementCosts.m_overlapBase = 3.0;
+  config.m_placementCosts.m_maxCost = 50;
+  state->setConfig(config);
+  EXPECT_EQ(wrapper.determineCost(12), 10 + 7);
+  EXPECT_EQ(wrapper.determineCost(11), 30 + 7);
+  EXPECT_EQ(wrapper.determineCost(10), 50); // 90 + 7 capped
+
+  suite.setConfig(config);
+  EXPECT_EQ(suite.getConfig().m_placementCosts.m_maxCost, 50);
+}
+
+TEST(EmbeddingTest, Deterministic_Seeded_Runs)
+{
+  graph_t clique = generate_completegraph(12);
+  graph_t chimera = generate_chimera(5, 5);
+  auto run = [&](uint64_t seed){
+    EmbeddingSuite suite{clique, chimera};
+    suite.setSeed(seed);
+    auto embedding = suite.find_embedding();
+    EXPECT_TRUE(suite.connectsNodes());
+    Vector<fuint32_pair_t> sorted(embedding.begin(), embedding.end());
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+  };
+  auto first = run(1234);
+  auto second = run(1234);
+  EXPECT_EQ(first, second);
+}
+
 TEST(EmbeddingTest, Basic_Cycle_8_Visualization)
 {
   graph_t cycle = generate_cyclegraph(8);
@@ -171,6 +260,240 @@ TEST(EmbeddingTest, Petersen_KingsGraph)
   ASSERT_TRUE(suite.connectsNodes());
 }
 
+TEST(EmbeddingTest, Petersen_KingsGraph_Async_Visualization)
+{
+  graph_t petersen = generate_petersen();
+  graph_t king = generate_king(10, 10);
+  std::filesystem::remove_all("imgs/Petersen_KingsGraph_Async");
+  auto visualizer = std::make_unique<KingsVisualizer>(petersen, king, "imgs/Petersen_KingsGraph_Async/king_petersen", 10, 10);
+  // large enough that no frame is dropped
+  visualizer->setAsync(true, 1000000);
+  visualizer->setSampling(2);
+  EmbeddingSuite suite{petersen, king, visualizer.get()};
+  auto embedding = suite.find_embedding();
+  ASSERT_TRUE(suite.connectsNodes());
+
+  // every second requested frame and the forced final frame, written before find_embedding returns
+  fuint32_t nbRequested = visualizer->getNbRequestedFrames();
+  EXPECT_GT(nbRequested, 0);
+  EXPECT_EQ(visualizer->getNbDroppedFrames(), 0);
+  EXPECT_EQ(countFiles("imgs/Petersen_KingsGraph_Async", ".svg"), (nbRequested + 1) / 2 + 1);
+}
+
+TEST(EmbeddingTest, Async_Visualization_Drops_Only_Sampled_Frames)
+{
+  graph_t clique = generate_completegraph(8);
+  graph_t chimera = generate_chimera(4, 4);
+  embedding_mapping_t mapping{};
+  for (vertex_t vertex = 0; vertex < 8; ++vertex) mapping.insert(std::make_pair(vertex, 8 * vertex));
+  std::filesystem::remove_all("imgs/Async_Visualization_Drops");
+  auto visualizer = std::make_unique<ChimeraVisualizer>(clique, chimera, "imgs/Async_Visualization_Drops/chimera", 4, 4);
+  visualizer->setAsync(true, 1);
+  visualizer->setSampling(3);
+
+  const fuint32_t nbRequested = 200, nbForced = 5;
+  for (fuint32_t idx = 0; idx < nbRequested; ++idx) visualizer->draw(mapping, "sampled");
+  for (fuint32_t idx = 0; idx < nbForced; ++idx) visualizer->draw(mapping, "forced", true);
+  visualizer->flush();
+
+  // the queue holds a single frame, so sampled frames can be dropped while the
+  // worker renders. How many depends on the scheduling, the forced ones never are.
+  fuint32_t nbSampled = (nbRequested + 2) / 3;
+  fuint32_t nbDropped = visualizer->getNbDroppedFrames();
+  EXPECT_EQ(visualizer->getNbRequestedFrames(), nbRequested);
+  EXPECT_LE(nbDropped, nbSampled);
+  fuint32_t nbWritten = nbSampled - nbDropped + nbForced;
+  EXPECT_EQ(countFiles("imgs/Async_Visualization_Drops", ".svg"), nbWritten);
+
+  // the forced frames are the last ones written
+  for (fuint32_t frame = nbWritten - nbForced + 1; frame <= nbWritten; ++frame)
+  {
+    std::ifstream file("imgs/Async_Visualization_Drops/chimera_" + std::to_string(frame) + ".svg");
+    std::stringstream content{};
+    content << file.rdbuf();
+    EXPECT_NE(content.str().find("forced"), std::string::npos);
+  }
+}
+
+TEST(EmbeddingTest, Incremental_Visualization_Matches_Fresh_Frame)
+{
+  graph_t clique = generate_completegraph(5);
+  graph_t chimera = generate_chimera(2, 2);
+  auto readFrame = [](const std::string& filename){
+    std::ifstream file(filename);
+    std::stringstream content{};
+    content << file.rdbuf();
+    std::string svg = content.str();
+    // the title contains the number of the frame
+    size_t begin = svg.find("Iteration ");
+    size_t end = svg.find(":", begin);
+    return svg.erase(begin, end - begin);
+  };
+
+  embedding_mapping_t mapping{};
+  for (const auto& mapped : Vector<fuint32_pair_t>{ {0,0}, {1,4}, {2,5}, {2,1} }) mapping.insert(mapped);
+  ChimeraVisualizer incremental{clique, chimera, "imgs/Incremental_Visualization/incremental", 2, 2};
+  incremental.draw(mapping, "frame");
+  for (const auto& mapped : Vector<fuint32_pair_t>{ {3,6}, {4,6}, {4,2}, {0,1} }) mapping.insert(mapped);
+  eraseSinglePair(mapping, (vertex_t)2, (vertex_t)1);
+  incremental.draw(mapping, "frame");
+
+  ChimeraVisualizer fresh{clique, chimera, "imgs/Incremental_Visualization/fresh", 2, 2};
+  fresh.draw(mapping, "frame");
+  std::string frame = readFrame("imgs/Incremental_Visualization/fresh_1.svg");
+  EXPECT_EQ(readFrame("imgs/Incremental_Visualization/incremental_2.svg"), frame);
+
+  // circle ids count the chains on a target from 2, the outermost circle has the largest id
+  EXPECT_NE(frame.find("id=\"node_0_2\""), std::string::npos);
+  EXPECT_NE(frame.find("id=\"node_6_2\""), std::string::npos);
+  EXPECT_NE(frame.find("id=\"node_6_3\""), std::string::npos);
+  EXPECT_EQ(frame.find("id=\"node_6_4\""), std::string::npos);
+}
+
+TEST(EmbeddingTest, Petersen_Chimera_Trace_Replay)
+{
+  graph_t petersen = generate_petersen();
+  graph_t chimera = generate_chimera(2, 2);
+  embedding_mapping_t embedding{};
+  {
+    EmbeddingTrace trace{"imgs/Petersen_Chimera_Trace/petersen.trace", petersen, chimera};
+    EmbeddingSuite suite{petersen, chimera};
+    suite.setTrace(&trace);
+    embedding = suite.find_embedding();
+  }
+
+  TraceReplay replay{"imgs/Petersen_Chimera_Trace/petersen.trace"};
+  EXPECT_EQ(replay.getSourceGraph().size(), petersen.size());
+  EXPECT_EQ(replay.getTargetGraph().size(), chimera.size());
+  ASSERT_GT(replay.getNbFrames(), 0);
+
+  // the last frame is the final embedding
+  auto last = replay.getFrame(replay.getNbFrames() - 1);
+  Vector<fuint32_pair_t> expected(embedding.begin(), embedding.end());
+  Vector<fuint32_pair_t> replayed(last.begin(), last.end());
+  std::sort(expected.begin(), expected.end());
+  std::sort(replayed.begin(), replayed.end());
+  EXPECT_EQ(expected, replayed);
+
+  std::filesystem::remove_all("imgs/Petersen_Chimera_Trace/frames");
+  ChimeraVisualizer visualizer{replay.getSourceGraph(), replay.getTargetGraph(),
+    "imgs/Petersen_Chimera_Trace/frames/petersen", 2, 2};
+  fuint32_t nbFrames = replay.getNbFrames();
+  fuint32_t nbRendered = (nbFrames + 3) / 4 + ((nbFrames - 1) % 4 != 0 ? 1 : 0);
+  EXPECT_EQ(replay.render(visualizer, 4), nbRendered);
+  EXPECT_EQ(countFiles("imgs/Petersen_Chimera_Trace/frames", ".svg"), nbRendered);
+
+  // a phase label longer than the remaining file must not wrap the bounds check
+  {
+    std::ofstream file("imgs/Petersen_Chimera_Trace/corrupt.trace", std::ios::binary | std::ios::trunc);
+    const char header[] = { 'M', 'M', 'T', 'R', 'A', 'C', 'E', 0, 1, 0, 0, (char)TRACE_PHASE_MARKER };
+    file.write(header, sizeof(header));
+    for (int idx = 0; idx < 9; ++idx) file.put((char)0xFF);
+    file.put(1); // label length 2^64 - 1
+  }
+  EXPECT_THROW(TraceReplay{"imgs/Petersen_Chimera_Trace/corrupt.trace"}, std::runtime_error);
+}
+
+TEST(EmbeddingTest, Clique_Chimera_Profile)
+{
+  graph_t clique = generate_completegraph(8);
+  graph_t chimera = generate_chimera(4, 4);
+  EmbeddingSuite suite{clique, chimera};
+  suite.setSeed(3);
+  suite.setProfiling(true);
+  auto embedding = suite.find_embedding();
+  ASSERT_TRUE(suite.connectsNodes());
+
+  // one placement and one mutation round per iteration of find_embedding
+  auto profile = suite.getProfile();
+  const ProfileEntry* placement = profile.find("placement");
+  const ProfileEntry* mutation = profile.find("mutation");
+  ASSERT_NE(placement, nullptr);
+  ASSERT_NE(mutation, nullptr);
+  EXPECT_EQ(placement->m_depth, 0);
+  EXPECT_GT(placement->m_count, 0);
+  EXPECT_EQ(mutation->m_count, placement->m_count);
+
+  // every vertex with more than one placed neighbor runs network simplex and the reducer
+  const ProfileEntry* networkSimplex = profile.find("placement/network simplex");
+  const ProfileEntry* reducer = profile.find("placement/super vertex reducer");
+  ASSERT_NE(networkSimplex, nullptr);
+  ASSERT_NE(reducer, nullptr);
+  EXPECT_EQ(networkSimplex->m_depth, 1);
+  EXPECT_EQ(reducer->m_count, networkSimplex->m_count);
+  EXPECT_LT(networkSimplex->m_count, placement->m_count);
+
+  // every mutation round ends with a synchronization
+  const ProfileEntry* synchronize = profile.find("mutation/synchronize");
+  ASSERT_NE(synchronize, nullptr);
+  EXPECT_GE(synchronize->m_count, mutation->m_count);
+  EXPECT_NE(profile.find("mutation/prepare"), nullptr);
+}
+
+TEST(EmbeddingTest, Profiler_Merges_Threads_By_Path)
+{
+  Profiler profiler{};
+  {
+    ProfileScope scope{profiler, "disabled"};
+  }
+  EXPECT_TRUE(profiler.report().m_entries.empty());
+
+  profiler.setEnabled(true);
+  {
+    ProfileScope outer{profiler, "outer"};
+    ProfileContext context = profiler.getContext();
+    ASSERT_EQ(context.size(), 1);
+    Vector<std::thread> threads{};
+    for (int idx = 0; idx < 4; ++idx)
+    {
+      threads.emplace_back([&](){
+        ProfileScope task{profiler, "task", context};
+        ProfileScope inner{profiler, "inner"};
+      });
+    }
+    for (auto& thread : threads) thread.join();
+    ProfileScope local{profiler, "task", context};
+  }
+  auto report = profiler.report();
+  ASSERT_EQ(report.m_entries.size(), 3);
+  EXPECT_EQ(report.m_entries[0].m_path, "outer");
+  EXPECT_EQ(report.find("outer")->m_count, 1);
+  ASSERT_NE(report.find("outer/task"), nullptr);
+  EXPECT_EQ(report.find("outer/task")->m_count, 5);
+  EXPECT_EQ(report.find("outer/task")->m_depth, 1);
+  ASSERT_NE(report.find("outer/task/inner"), nullptr);
+  EXPECT_EQ(report.find("outer/task/inner")->m_count, 4);
+}
+
+TEST(EmbeddingTest, Complete_Graph_12_On_Pegasus_4)
+{
+  graph_t clique = generate_completegraph(12);
+  graph_t pegasus = generate_pegasus(4);
+  auto visualizer = std::make_unique<PegasusVisualizer>(clique, pegasus, "imgs/Complete_Graph_12_On_Pegasus_4/pegasus_clique_12", 4);
+  EmbeddingSuite suite{clique, pegasus, visualizer.get()};
+  auto embedding = suite.find_embedding();
+  ASSERT_TRUE(suite.connectsNodes());
+}
+
+TEST(EmbeddingTest, Complete_Graph_8_On_Defective_Chimera)
+{
+  graph_t clique = generate_completegraph(8);
+  graph_t chimera = generate_chimera(4, 4);
+  TargetTopology topology{chimera};
+  for (uint64_t calibration = 0; calibration < 2; ++calibration)
+  { // the topology is reused for every calibration
+    DefectMask defects{topology};
+    RandomGen random{calibration};
+    for (int idx = 0; idx < 8; ++idx) defects.deactivateVertex(random.getRandomUint(127));
+    defects.deactivateEdge(0, 4);
+    defects.deactivateEdge(9, 13);
+    EmbeddingSuite suite{clique, topology, defects};
+    auto embedding = suite.find_embedding();
+    ASSERT_TRUE(suite.connectsNodes());
+    for (const auto& mapped : embedding) EXPECT_TRUE(defects.isVertexActive(mapped.second));
+  }
+}
+
 TEST(EmbeddingTest, DISABLED_TSP_7)
 {
   graph_t tsp = majorminer::quboTSP(7, [](fuint32_t, fuint32_t){ return 1;});
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+#include <common/random_gen.hpp>
+
+using namespace majorminer;
+
+
+TEST(RandomGenTest, Seeded_Streams_Reproducible)
+{
+  RandomGen genA{deriveSeed(42, 3)};
+  RandomGen genB{deriveSeed(42, 3)};
+  RandomGen genC{deriveSeed(42, 4)};
+  bool differs = false;
+  for (fuint32_t idx = 0; idx < 100; ++idx)
+  {
+    fuint32_t a = genA.getRandomUint(1000);
+    EXPECT_EQ(a, genB.getRandomUint(1000));
+    differs |= a != genC.getRandomUint(1000);
+  }
+  EXPECT_TRUE(differs);
+}
+
+TEST(RandomGenTest, Random_Uint_Bounds)
+{
+  RandomGen gen{7};
+  Vector<fuint32_t> histogram(5, 0);
+  for (fuint32_t idx = 0; idx < 1000; ++idx)
+  {
+    fuint32_t value = gen.getRandomUint(4);
+    ASSERT_LE(value, 4);
+    histogram[value]++;
+  }
+  for (auto count : histogram) EXPECT_GT(count, 0);
+  Vector<fuint32_t> elements{ 3, 5, 7 };
+  for (fuint32_t idx = 0; idx < 10; ++idx) EXPECT_EQ(gen.getRandomElement(elements) % 2, 1);
+}
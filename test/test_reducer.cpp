@@ -7,6 +7,8 @@
 #include <common/utils.hpp>
 #include <initial/csc_evolutionary.hpp>
 
+#include <functional>
+
 #include "utils/state_gen.hpp"
 
 using namespace majorminer;
@@ -35,7 +37,10 @@ namespace
     std::cout << "Worst is " << source << std::endl;
   }
 
-  void runTest(const graph_t& source, const graph_t& target, EmbeddingVisualizer* visualizer, vertex_t sourceVertex)
+  typedef std::function<void(const EvolutionaryCSCReducer&)> ReducerCheck;
+
+  void runTest(const graph_t& source, const graph_t& target, EmbeddingVisualizer* visualizer, vertex_t sourceVertex,
+    const EmbeddingConfig& config = EmbeddingConfig{}, const ReducerCheck& check = ReducerCheck{})
   {
     EmbeddingSuite suite{source, target};
     embedding_mapping_t mapping = suite.find_embedding();
@@ -43,11 +48,13 @@ namespace
     StateGen gen {source, target};
     gen.addMapping(mapping);
     auto state = gen.get();
+    state->setConfig(config);
 
     if (!isDefined(sourceVertex)) getWorstSource(mapping, sourceVertex);
     EvolutionaryCSCReducer reducer{*state, sourceVertex};
     reducer.setVisualizer(visualizer);
     reducer.optimize();
+    if (check) check(reducer);
 
     StateGen adjusted{source, target};
     adjusted.addMapping(mapping);
@@ -66,3 +73,39 @@ TEST(ReducerTest, SimpleEvoReducer)
   auto visualizer = std::make_unique<ChimeraVisualizer>(clique, chimera, "imgs/SimpleEvoReducer/SimpleEvoReducer", 8,8);
   runTest(clique, chimera, visualizer.get(), FUINT32_UNDEF);
 }
+
+TEST(ReducerTest, BudgetedEvoReducer)
+{
+  graph_t clique = majorminer::generate_completegraph(18);
+  graph_t chimera = majorminer::generate_chimera(8,8);
+  EmbeddingConfig config{};
+  config.m_evolutionary.m_populationSize = 16;
+  config.m_evolutionary.m_iterationLimit = 50;
+  config.m_evolutionary.m_evaluationBudget = 40;
+  config.m_evolutionary.m_timeBudgetMs = 2000;
+  runTest(clique, chimera, nullptr, FUINT32_UNDEF, config, [](const EvolutionaryCSCReducer& reducer){
+    // the budget is checked after every generation, which evaluates at most the population
+    EXPECT_LE(reducer.getNbEvaluations(), 40 + 16);
+    if (reducer.stoppedByBudget() && reducer.getElapsedMs() < 2000)
+    {
+      EXPECT_GE(reducer.getNbEvaluations(), 40);
+    }
+  });
+}
+
+TEST(ReducerTest, TimeBudgetedEvoReducer)
+{
+  graph_t clique = majorminer::generate_completegraph(18);
+  graph_t chimera = majorminer::generate_chimera(8,8);
+  EmbeddingConfig config{};
+  config.m_evolutionary.m_populationSize = 16;
+  config.m_evolutionary.m_iterationLimit = 1000000;
+  config.m_evolutionary.m_timeBudgetMs = 50;
+  runTest(clique, chimera, nullptr, FUINT32_UNDEF, config, [](const EvolutionaryCSCReducer& reducer){
+    // the reducer may also stop early when no new generation can be created
+    if (reducer.stoppedByBudget())
+    {
+      EXPECT_GE(reducer.getElapsedMs(), 50);
+    }
+  });
+}
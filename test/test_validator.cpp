@@ -0,0 +1,154 @@
+#include "utils/test_common.hpp"
+
+#include <common/graph_gen.hpp>
+#include <common/embedding_state.hpp>
+#include <common/embedding_analyzer.hpp>
+
+using namespace majorminer;
+
+namespace
+{
+  ValidationReport validateMapping(const graph_t& source, const graph_t& target,
+    std::initializer_list<fuint32_pair_t> mapping)
+  {
+    EmbeddingState state{source, target, nullptr};
+    for (const auto& mapped : mapping) state.mapNode(mapped.first, mapped.second);
+    EmbeddingValidator validator{state};
+    return validator.validate();
+  }
+}
+
+TEST(ValidatorTest, Valid_Triangle_On_Cycle_4)
+{
+  graph_t triangle = generate_cyclegraph(3);
+  graph_t cycle = generate_cyclegraph(4);
+  auto report = validateMapping(triangle, cycle, { {0,0}, {1,1}, {2,2}, {2,3} });
+  EXPECT_TRUE(report.isValid());
+}
+
+TEST(ValidatorTest, Overlapping_And_Uncovered)
+{
+  graph_t triangle = generate_cyclegraph(3);
+  graph_t cycle = generate_cyclegraph(4);
+  auto overlap = validateMapping(triangle, cycle, { {0,0}, {1,1}, {2,1} });
+  EXPECT_EQ(overlap.m_nbOverlappedTargets, 1);
+  EXPECT_TRUE(overlap.edgesCovered());
+  EXPECT_FALSE(overlap.isValid());
+
+  auto uncovered = validateMapping(triangle, cycle, { {0,0}, {1,1}, {2,2} });
+  EXPECT_TRUE(uncovered.isDisjoint());
+  EXPECT_EQ(uncovered.m_nbUncoveredEdges, 1);
+
+  auto unmapped = validateMapping(triangle, cycle, { {0,0}, {1,1} });
+  EXPECT_EQ(unmapped.m_nbUnmappedVertices, 1);
+  EXPECT_FALSE(unmapped.edgesCovered());
+}
+
+TEST(ValidatorTest, Disconnected_Chain)
+{
+  graph_t path{};
+  addEdges(path, { {0,1} });
+  graph_t cycle = generate_cyclegraph(6);
+  auto report = validateMapping(path, cycle, { {0,0}, {0,3}, {1,1} });
+  EXPECT_EQ(report.m_nbDisconnectedChains, 1);
+  EXPECT_TRUE(report.edgesCovered());
+  EXPECT_FALSE(report.isValid());
+}
+
+TEST(ValidatorTest, Clique_On_Chimera)
+{
+  graph_t clique = generate_completegraph(12);
+  graph_t chimera = generate_chimera(5, 5);
+  EmbeddingSuite suite{clique, chimera};
+  suite.find_embedding();
+  ASSERT_TRUE(suite.connectsNodes());
+}
+
+TEST(ValidatorTest, Tracker_Matches_Validator)
+{
+  graph_t clique = generate_completegraph(5);
+  graph_t chimera = generate_chimera(2, 2);
+  EmbeddingState state{clique, chimera, nullptr};
+  EmbeddingValidator validator{state};
+  auto& tracker = state.getValidityTracker();
+  auto expectEqualCounters = [&](){
+    auto report = validator.validate();
+    EXPECT_EQ(tracker.getNbOverlappedTargets(), report.m_nbOverlappedTargets);
+    EXPECT_EQ(tracker.getNbUncoveredEdges(), report.m_nbUncoveredEdges);
+    EXPECT_EQ(tracker.getNbUnmappedVertices(), report.m_nbUnmappedVertices);
+    EXPECT_EQ(tracker.getNbDisconnectedChains(), report.m_nbDisconnectedChains);
+    EXPECT_EQ(tracker.isValid(), report.isValid());
+  };
+  expectEqualCounters();
+  EXPECT_EQ(tracker.getNbUncoveredEdges(), 10);
+
+  RandomGen random{7};
+  for (int iteration = 0; iteration < 200; ++iteration)
+  {
+    vertex_t source = random.getRandomUint(4);
+    if (state.getSuperVertexSize(source) > 0 && random.getRandomUint(2) == 0)
+    {
+      state.unmapNode(source);
+    }
+    else
+    {
+      nodeset_t chain{};
+      for (fuint32_t idx = 0; idx <= random.getRandomUint(2); ++idx) chain.insert(random.getRandomUint(31));
+      state.unmapNode(source);
+      state.mapNode(source, chain);
+    }
+    expectEqualCounters();
+  }
+}
+
+TEST(ValidatorTest, Tracker_After_Embedding)
+{
+  graph_t clique = generate_completegraph(15);
+  graph_t chimera = generate_chimera(7, 7);
+  EmbeddingSuite suite{clique, chimera};
+  suite.find_embedding();
+  auto& tracker = suite.getValidityTracker();
+  EXPECT_EQ(tracker.isValid(), suite.isValid());
+  EXPECT_EQ(tracker.getNbUncoveredEdges() == 0, suite.connectsNodes());
+  EXPECT_DOUBLE_EQ(tracker.getProgress(), 1.0);
+}
+
+TEST(AnalyzerTest, Statistics_Of_Path_On_Cycle_6)
+{
+  graph_t path{};
+  addEdges(path, { {0,1}, {1,2} });
+  graph_t cycle = generate_cyclegraph(6);
+  embedding_mapping_t mapping{};
+  for (const auto& mapped : Vector<fuint32_pair_t>{ {0,0}, {0,1}, {1,2}, {1,3}, {1,4}, {2,4}, {2,5} })
+  {
+    mapping.insert(mapped);
+  }
+  EmbeddingAnalyzer analyzer{mapping, path, cycle};
+  analyzer.setRegions(2, [](vertex_t target){ return target / 3; });
+  auto stats = analyzer.analyze();
+
+  EXPECT_EQ(stats.m_nbChains, 3);
+  EXPECT_EQ(stats.m_nbUsedTargets, 6);
+  EXPECT_EQ(stats.m_nbOverlappedTargets, 1);
+  EXPECT_EQ(stats.m_maxChainLength, 3);
+  EXPECT_DOUBLE_EQ(stats.m_meanChainLength, 7.0 / 3);
+  EXPECT_EQ(stats.m_p95ChainLength, 3);
+  EXPECT_EQ(stats.m_chainLengths, (Vector<fuint32_t>{ 0, 0, 2, 1 }));
+
+  // {0,1} is coupled by the target edge (1,2), {1,2} by (3,4) and (4,5)
+  EXPECT_EQ(stats.m_nbLogicalEdges, 2);
+  EXPECT_EQ(stats.m_nbUncoupledEdges, 0);
+  EXPECT_EQ(stats.m_maxCouplers, 2);
+  EXPECT_EQ(stats.m_couplers, (Vector<fuint32_t>{ 0, 1, 1 }));
+
+  EXPECT_EQ(stats.m_regionSizes, (Vector<fuint32_t>{ 3, 3 }));
+  EXPECT_EQ(stats.m_regionUsed, (Vector<fuint32_t>{ 3, 3 }));
+  ASSERT_EQ(stats.m_hotspots.size(), 1);
+  EXPECT_EQ(stats.m_hotspots[0].first, 4);
+  EXPECT_EQ(stats.m_hotspots[0].second, 2);
+
+  std::string json = stats.toJSON();
+  EXPECT_NE(json.find("\"chains\": 3"), std::string::npos);
+  EXPECT_NE(json.find("\"histogram\": [0, 0, 2, 1]"), std::string::npos);
+  EXPECT_NE(json.find("{ \"target\": 4, \"chains\": 2 }"), std::string::npos);
+}
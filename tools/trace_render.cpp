@@ -0,0 +1,70 @@
+#include <common/embedding_trace.hpp>
+#include <common/embedding_visualizer.hpp>
+
+#include <iostream>
+#include <string>
+
+using namespace majorminer;
+
+namespace
+{
+  void printUsage(const char* name)
+  {
+    std::cerr << "Usage: " << name << " <trace> <output prefix> <layout> [every n-th frame]" << std::endl
+              << "Layouts: chimera <rows> <cols> | king <rows> <cols> | pegasus <m>" << std::endl;
+  }
+
+  fuint32_t parseNumber(const char* arg)
+  {
+    return static_cast<fuint32_t>(std::stoul(arg));
+  }
+}
+
+// Renders the frames of an embedding trace to SVG files.
+int main(int argc, char** argv)
+{
+  if (argc < 5)
+  {
+    printUsage(argv[0]);
+    return 1;
+  }
+  try
+  {
+    TraceReplay replay{argv[1]};
+    std::string output = argv[2];
+    std::string layout = argv[3];
+    const graph_t& source = replay.getSourceGraph();
+    const graph_t& target = replay.getTargetGraph();
+
+    std::unique_ptr<EmbeddingVisualizer> visualizer;
+    int nextArg = 0;
+    if ((layout == "chimera" || layout == "king") && argc >= 6)
+    {
+      fuint32_t rows = parseNumber(argv[4]);
+      fuint32_t cols = parseNumber(argv[5]);
+      if (layout == "chimera") visualizer = std::make_unique<ChimeraVisualizer>(source, target, output, rows, cols);
+      else visualizer = std::make_unique<KingsVisualizer>(source, target, output, rows, cols);
+      nextArg = 6;
+    }
+    else if (layout == "pegasus")
+    {
+      visualizer = std::make_unique<PegasusVisualizer>(source, target, output, parseNumber(argv[4]));
+      nextArg = 5;
+    }
+    else
+    {
+      printUsage(argv[0]);
+      return 1;
+    }
+
+    fuint32_t everyNth = nextArg < argc ? parseNumber(argv[nextArg]) : 1;
+    fuint32_t nbRendered = replay.render(*visualizer, everyNth);
+    std::cout << "Rendered " << nbRendered << " of " << replay.getNbFrames() << " frames from " << argv[1] << std::endl;
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}